@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ziqi Fan
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Cross-language CDR conformance and throughput comparison
+
+Runs the corpus check of every codec (cpp/cdr_corpus.cpp, rust/src/bin/cdr_corpus.rs,
+python/corpus.py) against the golden files in this directory and prints one table.
+Each check compares its encoding with <case>.cdr byte for byte, so all codecs
+reporting "ok" means they produce identical bytes.
+
+Exits with 1 if no codec ran, or if any codec that ran exits with an error, reports a
+mismatch or decode error, or leaves out a case. A codec whose binary is not built is
+reported and skipped.
+"""
+
+import argparse
+import csv
+import glob
+import io
+import os
+import subprocess
+import sys
+
+CORPUS = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(CORPUS)
+
+TOOLS = {
+    "cpp": [os.path.join(ROOT, "cpp", "build", "cdr_corpus")],
+    "rust": [os.path.join(ROOT, "rust", "target", "release", "cdr_corpus")],
+    "python": [sys.executable, os.path.join(ROOT, "python", "corpus.py")],
+}
+
+
+def run_tool(lang, min_seconds):
+    """Run one codec check; returns (rows, error), error being None on a clean exit"""
+    try:
+        proc = subprocess.run(TOOLS[lang] + [CORPUS, str(min_seconds)], capture_output=True, text=True)
+    except OSError as e:
+        return [], str(e)
+    if proc.stderr:
+        sys.stderr.write(proc.stderr)
+    # A row cut short by a crash has missing fields; drop it so its case counts as missing
+    rows = [row for row in csv.DictReader(io.StringIO(proc.stdout)) if None not in row.values()]
+    if proc.returncode != 0:
+        return rows, f"exited with status {proc.returncode}"
+    return rows, None
+
+
+def cell(row):
+    if row is None:
+        return "missing"
+    if row["result"] != "ok":
+        return row["result"]
+    return f"{float(row['encode_mb_s']):.1f} / {float(row['decode_mb_s']):.1f}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare CDR codecs against the golden corpus")
+    parser.add_argument("--languages", type=str, default="cpp,rust,python", help="Comma separated")
+    parser.add_argument("--min-seconds", type=float, default=0.2, help="Minimum time per benchmark")
+    parser.add_argument("--csv", type=str, help="Also write all rows to this CSV file")
+    args = parser.parse_args()
+
+    langs = [lang for lang in args.languages.split(",") if lang]
+    unknown = [lang for lang in langs if lang not in TOOLS]
+    if unknown:
+        parser.error(f"unknown languages: {', '.join(unknown)} (choose from {', '.join(TOOLS)})")
+
+    rows = {}
+    failed = False
+    for lang in langs:
+        if not os.path.exists(TOOLS[lang][-1]):
+            print(f"{lang}: skipped, not built ({TOOLS[lang][-1]})")
+            continue
+        result, error = run_tool(lang, args.min_seconds)
+        if error:
+            print(f"{lang}: FAIL, {error}")
+            failed = True
+        rows[lang] = {row["case"]: row for row in result}
+    if not rows:
+        print("FAIL: no codec ran")
+        sys.exit(1)
+
+    # Every golden file is a case each codec must report, as a result or an explicit skip
+    cases = sorted(os.path.splitext(os.path.basename(path))[0] for path in glob.glob(os.path.join(CORPUS, "*.cdr")))
+    for table in rows.values():
+        cases += [case for case in table if case not in cases]
+
+    print()
+    header = f"{'case':<18}{'bytes':>8}  " + "".join(f"{lang + ' enc/dec MB/s':<24}" for lang in rows)
+    print(header.rstrip())
+    for case in cases:
+        size = next((table[case]["bytes"] for table in rows.values() if case in table), "")
+        line = f"{case:<18}{size:>8}  "
+        for table in rows.values():
+            row = table.get(case)
+            line += f"{cell(row):<24}"
+            failed = failed or row is None or row["result"] not in ("ok", "skipped")
+        print(line.rstrip())
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["lang", "case", "result", "bytes", "encode_ns", "decode_ns", "encode_mb_s", "decode_mb_s"])
+            for table in rows.values():
+                for row in table.values():
+                    writer.writerow(row.values())
+
+    print()
+    if failed:
+        print("FAIL: codecs failed or disagree with the golden corpus")
+        sys.exit(1)
+    print(f"OK: {', '.join(rows)} match the golden corpus")
+
+
+if __name__ == "__main__":
+    main()
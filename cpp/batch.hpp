@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+/**
+ * Batched multi-message frames for high-rate small messages
+ *
+ * Packs many CDR messages into one frame so a single put carries them all.
+ * Only for Zenoh-native consumers: the bridge does not understand frames, so
+ * topics forwarded to ROS2 must keep using one put per message.
+ *
+ * Frame layout (little endian):
+ *   uint32 count
+ *   count x { uint32 len, len bytes of CDR (including the 4-byte CDR header) }
+ *
+ * A frame is flushed when max_count messages or max_bytes are reached, or
+ * when the oldest pending message is older than max_delay_us (checked by
+ * add() and poll()).
+ *
+ * Usage:
+ *   batch::Batcher batcher([&](const uint8_t* frame, size_t len) { put(frame, len); });
+ *   batcher.add(twist);
+ *   batcher.poll();
+ *
+ *   batch::for_each(frame, len, [](const uint8_t* data, size_t len) {
+ *       msg::Twist twist;
+ *       msg::deserialize(data, len, twist);
+ *   });
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "cdr.hpp"
+
+namespace batch {
+
+class Batcher {
+   public:
+    using FlushFn = std::function<void(const uint8_t*, size_t)>;
+
+    explicit Batcher(FlushFn flush, size_t max_count = 64, size_t max_bytes = 8192,
+                     uint64_t max_delay_us = 1000)
+        : flush_(std::move(flush)),
+          max_count_(max_count),
+          max_bytes_(max_bytes),
+          max_delay_(std::chrono::microseconds(max_delay_us)) {
+        frame_.reserve(max_bytes_ + 64);
+        frame_.resize(4);
+    }
+
+    ~Batcher() { flush(); }
+
+    Batcher(const Batcher&) = delete;
+    Batcher& operator=(const Batcher&) = delete;
+
+    // Serialize msg into a reused writer buffer, then copy it into the frame
+    template <typename T>
+    void add(const T& msg) {
+        writer_.clear();
+        writer_ << msg;
+        const auto& body = writer_.body();
+        static const uint8_t header[4] = {0x00, 0x01, 0x00, 0x00};
+        begin_message(4 + body.size());
+        append(header, 4);
+        append(body.data(), body.size());
+        end_message();
+    }
+
+    // Add an already serialized CDR payload
+    void add_raw(const uint8_t* data, size_t len) {
+        begin_message(len);
+        append(data, len);
+        end_message();
+    }
+
+    // Flush if the oldest pending message has waited longer than max_delay_us
+    void poll() {
+        if (count_ > 0 && std::chrono::steady_clock::now() - first_ >= max_delay_) flush();
+    }
+
+    void flush() {
+        if (count_ == 0) return;
+        uint32_t count = static_cast<uint32_t>(count_);
+        memcpy(frame_.data(), &count, 4);
+        flush_(frame_.data(), frame_.size());
+        frame_.resize(4);
+        count_ = 0;
+    }
+
+    size_t pending() const { return count_; }
+
+   private:
+    void begin_message(size_t len) {
+        // Flush first if this message would overflow the byte limit
+        if (count_ > 0 && frame_.size() + 4 + len > max_bytes_) flush();
+        if (count_ == 0) first_ = std::chrono::steady_clock::now();
+        uint32_t n = static_cast<uint32_t>(len);
+        append(&n, 4);
+    }
+    void end_message() {
+        count_++;
+        if (count_ >= max_count_ || frame_.size() >= max_bytes_) {
+            flush();
+        } else {
+            poll();
+        }
+    }
+    void append(const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        frame_.insert(frame_.end(), p, p + len);
+    }
+
+    FlushFn flush_;
+    size_t max_count_;
+    size_t max_bytes_;
+    std::chrono::steady_clock::duration max_delay_;
+    std::chrono::steady_clock::time_point first_;
+    std::vector<uint8_t> frame_;
+    size_t count_ = 0;
+    cdr::Writer writer_;
+};
+
+// Call fn(data, len) for each message in frame; views point into frame (no copy).
+// Returns false if the frame is truncated or malformed.
+template <typename F>
+bool for_each(const uint8_t* frame, size_t len, F&& fn) {
+    if (len < 4) return false;
+    uint32_t count;
+    memcpy(&count, frame, 4);
+    size_t pos = 4;
+    for (uint32_t i = 0; i < count; i++) {
+        if (pos + 4 > len) return false;
+        uint32_t n;
+        memcpy(&n, frame + pos, 4);
+        pos += 4;
+        if (n > len - pos) return false;
+        fn(frame + pos, static_cast<size_t>(n));
+        pos += n;
+    }
+    return true;
+}
+
+}  // namespace batch
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Parallel batch decode scaling (cdr_batch.hpp)
+ *
+ * Serializes N msg::Twist payloads, then decodes the whole batch with
+ * 1..hardware_concurrency threads, both into an array of Twist and into
+ * structure-of-arrays columns. Prints the best time of each configuration
+ * and its speedup over one thread.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "cdr_batch.hpp"
+#include "msg.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " [count] [repeats]" << std::endl;
+    std::cout << "  count: payloads per batch (default 1000000)" << std::endl;
+    std::cout << "  repeats: runs per thread count, best is reported (default 5)" << std::endl;
+    std::cout << "Example: " << prog << " 1000000 5" << std::endl;
+}
+
+// Best wall time of repeats runs of decode, in seconds
+template <typename F>
+double best_seconds(int repeats, F decode) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        decode();
+        best = std::min(
+            best,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    long count = (argc > 1) ? std::atol(argv[1]) : 1000000;
+    int repeats = (argc > 2) ? std::atoi(argv[2]) : 5;
+    if (count <= 0 || repeats <= 0) {
+        std::cerr << "Error: count and repeats must be positive" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Varied values so every payload is distinct
+    std::vector<std::vector<uint8_t>> buffers(count);
+    for (long i = 0; i < count; i++) {
+        msg::Twist twist;
+        twist.linear = {i * 0.001, -i * 0.002, 0.5};
+        twist.angular = {0.0, 0.0, i * 0.01};
+        buffers[i] = cdr::serialize(twist);
+    }
+    std::vector<cdr::Span> payloads(count);
+    for (long i = 0; i < count; i++) payloads[i] = {buffers[i].data(), buffers[i].size()};
+
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Batch decode: " << count << " x msg::Twist (" << buffers[0].size()
+              << " bytes), best of " << repeats << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::setw(14) << "array ms"
+              << std::setw(12) << "speedup" << std::setw(14) << "columns ms" << "speedup"
+              << std::endl;
+
+    std::vector<msg::Twist> out(count);
+    cdr::SoA<msg::Twist> columns;
+    double array_base = 0;
+    double columns_base = 0;
+    for (size_t threads = 1; threads <= max_threads; threads++) {
+        cdr::ThreadPool pool(threads);
+        size_t decoded = 0;
+
+        double array_s = best_seconds(repeats, [&] {
+            decoded = cdr::deserialize_batch(pool, payloads.data(), payloads.size(), out.data());
+        });
+        if (decoded != payloads.size()) {
+            std::cerr << "Decode failed: " << decoded << " of " << count << std::endl;
+            return 1;
+        }
+
+        double columns_s = best_seconds(repeats, [&] {
+            decoded = cdr::deserialize_batch(pool, payloads.data(), payloads.size(), columns);
+        });
+        if (decoded != payloads.size()) {
+            std::cerr << "Decode failed: " << decoded << " of " << count << std::endl;
+            return 1;
+        }
+
+        if (threads == 1) {
+            array_base = array_s;
+            columns_base = columns_s;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << threads
+                  << std::setw(14) << array_s * 1e3 << std::setw(12) << array_base / array_s
+                  << std::setw(14) << columns_s * 1e3 << columns_base / columns_s << std::endl;
+    }
+
+    // Spot check the last row against the source values
+    const msg::Twist& last = out[count - 1];
+    const double* angular_z = columns.column<double>(5);
+    if (last.angular.z != (count - 1) * 0.01 || angular_z[count - 1] != last.angular.z) {
+        std::cerr << "Decoded values do not match" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "batch.hpp"
+#include "msg.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog
+              << " <bridge_address> [rate_hz] [max_count] [max_bytes] [max_delay_us]" << std::endl;
+    std::cout << "Example: " << prog << " localhost:7447 20000 64 8192 1000" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Error: Bridge address must be specified" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    const char* bridge_addr = argv[1];
+    double rate_hz = (argc > 2) ? std::atof(argv[2]) : 20000;
+    size_t max_count = (argc > 3) ? std::strtoul(argv[3], NULL, 10) : 64;
+    size_t max_bytes = (argc > 4) ? std::strtoul(argv[4], NULL, 10) : 8192;
+    uint64_t max_delay_us = (argc > 5) ? std::strtoull(argv[5], NULL, 10) : 1000;
+
+    // The period is 1 / rate_hz; keep it finite and representable as a clock duration
+    if (!(rate_hz >= 1e-3 && rate_hz <= 1e9)) {
+        std::cerr << "Error: rate_hz must be a number between 0.001 and 1e9" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    // Zenoh-native key: frames are not CDR messages, so they must not be routed to ROS2
+    z_owned_publisher_t publisher;
+    z_view_keyexpr_t keyexpr;
+    z_view_keyexpr_from_str(&keyexpr, "batch/cmd_vel");
+
+    if (z_declare_publisher(z_loan(session), &publisher, z_loan(keyexpr), NULL) < 0) {
+        std::cerr << "Failed to create publisher" << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    std::cout << "Zenoh batched cmd_vel publisher started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Topic: batch/cmd_vel (Zenoh only)" << std::endl;
+    std::cout << "  Rate: " << rate_hz << " Hz, flush at " << max_count << " msgs / " << max_bytes
+              << " bytes / " << max_delay_us << " us" << std::endl;
+    std::cout << std::endl;
+
+    uint64_t frames = 0;
+    // The frame buffer is reused after flush, so the payload is copied into the put
+    batch::Batcher batcher(
+        [&](const uint8_t* frame, size_t len) {
+            z_owned_bytes_t data;
+            z_bytes_copy_from_buf(&data, frame, len);
+            z_publisher_put(z_loan(publisher), z_move(data), NULL);
+            frames++;
+        },
+        max_count, max_bytes, max_delay_us);
+
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate_hz));
+    auto next = std::chrono::steady_clock::now();
+    auto report = next + std::chrono::seconds(1);
+    uint64_t count = 0;
+
+    while (true) {
+        msg::Twist twist{{static_cast<double>(count), 0, 0}, {0, 0, 0.2}};
+        batcher.add(twist);
+        count++;
+
+        next += period;
+        // Deadline flush is checked once per period, so it may lag by up to one period
+        std::this_thread::sleep_until(next);
+        batcher.poll();
+
+        if (std::chrono::steady_clock::now() >= report) {
+            std::cout << "Published " << count << " messages in " << frames << " frames"
+                      << std::endl;
+            count = 0;
+            frames = 0;
+            report += std::chrono::seconds(1);
+        }
+    }
+
+    batcher.flush();
+    z_drop(z_move(publisher));
+    z_drop(z_move(session));
+    return 0;
+}
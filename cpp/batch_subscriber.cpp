@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+#include "batch.hpp"
+#include "msg.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <bridge_address>" << std::endl;
+    std::cout << "Example: " << prog << " localhost:7447" << std::endl;
+}
+
+struct Stats {
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> errors{0};
+};
+
+void callback(z_loaned_sample_t* sample, void* arg) {
+    auto* stats = static_cast<Stats*>(arg);
+
+    // Frames are large by design and may arrive fragmented; those are copied into one buffer
+    const z_loaned_bytes_t* bytes = z_sample_payload(sample);
+    std::vector<uint8_t> copy;
+    const uint8_t* data;
+    size_t len;
+    z_view_slice_t payload;
+    if (z_bytes_get_contiguous_view(bytes, &payload) == Z_OK) {
+        data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+        len = z_slice_len(z_loan(payload));
+    } else {
+        copy.resize(z_bytes_len(bytes));
+        z_bytes_reader_t reader = z_bytes_get_reader(bytes);
+        if (z_bytes_reader_read(&reader, copy.data(), copy.size()) != copy.size()) {
+            stats->errors++;
+            return;
+        }
+        data = copy.data();
+        len = copy.size();
+    }
+
+    uint64_t count = 0;
+    bool ok = batch::for_each(data, len, [&](const uint8_t* msg_data, size_t msg_len) {
+        msg::Twist twist;
+        if (msg::deserialize(msg_data, msg_len, twist)) {
+            count++;
+        } else {
+            stats->errors++;
+        }
+    });
+    if (!ok) stats->errors++;
+
+    stats->messages += count;
+    stats->frames++;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Error: Bridge address must be specified" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* bridge_addr = argv[1];
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    std::cout << "Zenoh batched cmd_vel subscriber started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Topic: batch/cmd_vel (Zenoh only)" << std::endl;
+    std::cout << std::endl;
+
+    Stats stats;
+    z_owned_closure_sample_t closure;
+    z_closure_sample(&closure, callback, NULL, &stats);
+
+    z_view_keyexpr_t keyexpr;
+    z_view_keyexpr_from_str(&keyexpr, "batch/cmd_vel");
+
+    z_owned_subscriber_t subscriber;
+    if (z_declare_subscriber(z_loan(session), &subscriber, z_loan(keyexpr), z_move(closure), NULL) <
+        0) {
+        std::cerr << "Failed to create subscriber" << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    std::cout << "Waiting for messages... (Ctrl+C to exit)" << std::endl;
+
+    // Report rates once per second instead of printing every message
+    while (true) {
+        z_sleep_s(1);
+        std::cout << "Received " << stats.messages.exchange(0) << " messages in "
+                  << stats.frames.exchange(0) << " frames (" << stats.errors.exchange(0)
+                  << " errors)" << std::endl;
+    }
+
+    z_drop(z_move(subscriber));
+    z_drop(z_move(session));
+    return 0;
+}
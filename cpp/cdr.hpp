@@ -150,6 +150,12 @@ class Writer {
         return *this;
     }
 
+    // Serialized body without the 4-byte CDR header
+    const std::vector<uint8_t>& body() const { return buffer_; }
+
+    // Reuse the writer for another message, keeping the allocated buffer
+    void clear() { buffer_.clear(); }
+
     std::vector<uint8_t> finish() {
         std::vector<uint8_t> result;
         result.reserve(4 + buffer_.size());
@@ -0,0 +1,332 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+/**
+ * Parallel batch CDR decoding
+ *
+ * Decodes many buffered payloads across a work-stealing thread pool into
+ * preallocated output: either an array of T, or structure-of-arrays columns
+ * for fixed-layout types (only arithmetic fields, nested structs and fixed
+ * arrays, e.g. msg::Twist), one contiguous column per leaf field.
+ *
+ * Each participant starts with an equal slice of the batch and pops small
+ * grains from its front; once empty it steals the back half of another
+ * participant's slice, so uneven payload sizes still balance out.
+ *
+ * Usage:
+ *   std::vector<cdr::Span> payloads = ...;
+ *   std::vector<msg::Twist> out;
+ *   cdr::deserialize_batch(payloads, out);
+ *
+ *   cdr::SoA<msg::Twist> columns;
+ *   cdr::deserialize_batch(payloads, columns);
+ *   const double* linear_x = columns.column<double>(0);
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "cdr.hpp"
+
+namespace cdr {
+
+// A view of one serialized payload
+struct Span {
+    const uint8_t* data;
+    size_t len;
+};
+
+// ==================== Work-Stealing Thread Pool ====================
+
+class ThreadPool {
+   public:
+    // threads = 0 uses all hardware threads (the calling thread counts as one)
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        slices_.reset(new Slice[threads]);
+        for (size_t i = 1; i < threads; i++) workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    // Run fn(begin, end) over [0, n) in chunks of at most `grain`; blocks until done.
+    // The calling thread takes part. Calls are serialized per pool.
+    template <typename F>
+    void parallel_for(size_t n, size_t grain, F&& fn) {
+        std::lock_guard<std::mutex> call_lock(call_mutex_);
+        grain_ = std::max<size_t>(1, grain);
+        ctx_ = &fn;
+        call_ = [](void* ctx, size_t begin, size_t end) {
+            (*static_cast<std::remove_reference_t<F>*>(ctx))(begin, end);
+        };
+
+        // Slices are packed into 32 bits each, so very large batches run in windows
+        constexpr size_t kWindow = UINT32_MAX;
+        for (size_t base = 0; base < n; base += kWindow) {
+            base_ = base;
+            run_window(static_cast<uint32_t>(std::min(n - base, kWindow)));
+        }
+    }
+
+   private:
+    struct alignas(64) Slice {
+        std::atomic<uint64_t> bounds{0};  // begin << 32 | end
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return uint64_t(begin) << 32 | end; }
+
+    void run_window(uint32_t n) {
+        size_t parts = size();
+        for (size_t i = 0; i < parts; i++) {
+            uint32_t begin = static_cast<uint32_t>(n * i / parts);
+            uint32_t end = static_cast<uint32_t>(n * (i + 1) / parts);
+            slices_[i].bounds.store(pack(begin, end), std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ = workers_.size();
+            generation_++;
+        }
+        cv_.notify_all();
+
+        run(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    void worker_loop(size_t id) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            run(id);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+    // Drain our own slice, then steal until every slice is empty
+    void run(size_t id) {
+        uint32_t begin, end;
+        for (;;) {
+            while (pop(slices_[id], begin, end)) call_(ctx_, base_ + begin, base_ + end);
+            if (!steal(id)) return;
+        }
+    }
+
+    // Take one grain from the front of our own slice
+    bool pop(Slice& slice, uint32_t& begin, uint32_t& end) {
+        uint64_t cur = slice.bounds.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t lo = static_cast<uint32_t>(cur >> 32);
+            uint32_t hi = static_cast<uint32_t>(cur);
+            if (lo >= hi) return false;
+            uint32_t take = static_cast<uint32_t>(std::min<size_t>(grain_, hi - lo));
+            if (slice.bounds.compare_exchange_weak(cur, pack(lo + take, hi),
+                                                   std::memory_order_acq_rel)) {
+                begin = lo;
+                end = lo + take;
+                return true;
+            }
+        }
+    }
+
+    // Move the back half of another slice into our (empty) slice
+    bool steal(size_t id) {
+        size_t parts = size();
+        for (size_t k = 1; k < parts; k++) {
+            Slice& victim = slices_[(id + k) % parts];
+            uint64_t cur = victim.bounds.load(std::memory_order_acquire);
+            for (;;) {
+                uint32_t lo = static_cast<uint32_t>(cur >> 32);
+                uint32_t hi = static_cast<uint32_t>(cur);
+                if (lo >= hi) break;
+                uint32_t mid = (hi - lo <= grain_) ? lo : lo + (hi - lo) / 2;
+                if (victim.bounds.compare_exchange_weak(cur, pack(lo, mid),
+                                                        std::memory_order_acq_rel)) {
+                    slices_[id].bounds.store(pack(mid, hi), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<Slice[]> slices_;
+
+    std::mutex call_mutex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+
+    // Current job
+    void* ctx_ = nullptr;
+    void (*call_)(void*, size_t, size_t) = nullptr;
+    size_t grain_ = 1;
+    size_t base_ = 0;
+};
+
+// Shared pool sized to the machine, created on first use
+inline ThreadPool& default_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// ==================== Structure of Arrays ====================
+
+namespace detail {
+
+template <typename T>
+struct is_std_array : std::false_type {};
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+// Visit every arithmetic leaf of a fixed-layout type in declaration order
+template <typename T, typename F>
+void for_each_leaf(T& obj, F& fn) {
+    using U = std::remove_cv_t<T>;
+    if constexpr (std::is_arithmetic_v<U>) {
+        fn(obj);
+    } else if constexpr (std::is_array_v<U> || is_std_array<U>::value) {
+        for (auto& e : obj) for_each_leaf(e, fn);
+    } else {
+        static_assert(std::is_aggregate_v<U>,
+                      "SoA requires a fixed-layout type (no strings or sequences)");
+        boost::pfr::for_each_field(obj, [&fn](auto& field) { for_each_leaf(field, fn); });
+    }
+}
+
+}  // namespace detail
+
+// One contiguous column per leaf field of T, e.g. for msg::Twist:
+// 0..2 = linear.x/y/z, 3..5 = angular.x/y/z
+template <typename T>
+class SoA {
+   public:
+    SoA() {
+        T sample{};
+        auto collect = [this](const auto& leaf) { leaf_size_.push_back(sizeof(leaf)); };
+        detail::for_each_leaf(sample, collect);
+        columns_.resize(leaf_size_.size());
+    }
+
+    void resize(size_t rows) {
+        for (size_t i = 0; i < columns_.size(); i++) columns_[i].resize(rows * leaf_size_[i]);
+        rows_ = rows;
+    }
+
+    size_t size() const { return rows_; }
+    size_t fields() const { return columns_.size(); }
+
+    template <typename L>
+    L* column(size_t field) {
+        return reinterpret_cast<L*>(columns_[field].data());
+    }
+    template <typename L>
+    const L* column(size_t field) const {
+        return reinterpret_cast<const L*>(columns_[field].data());
+    }
+
+    // Scatter obj into row
+    void set(size_t row, const T& obj) {
+        size_t field = 0;
+        auto scatter = [&](const auto& leaf) {
+            memcpy(columns_[field].data() + row * sizeof(leaf), &leaf, sizeof(leaf));
+            field++;
+        };
+        detail::for_each_leaf(obj, scatter);
+    }
+
+   private:
+    std::vector<size_t> leaf_size_;
+    std::vector<std::vector<uint8_t>> columns_;
+    size_t rows_ = 0;
+};
+
+// ==================== Batch Decode ====================
+
+// Grain small enough to balance, large enough to amortize scheduling
+constexpr size_t kBatchGrain = 256;
+
+// Decode payloads[i] into out[i]; out must hold count elements. ok[i] (optional)
+// receives the per-payload result. Returns the number decoded successfully.
+template <typename T>
+size_t deserialize_batch(ThreadPool& pool, const Span* payloads, size_t count, T* out,
+                         uint8_t* ok = nullptr) {
+    std::atomic<size_t> decoded{0};
+    pool.parallel_for(count, kBatchGrain, [&](size_t begin, size_t end) {
+        size_t n = 0;
+        for (size_t i = begin; i < end; i++) {
+            bool r = deserialize(payloads[i].data, payloads[i].len, out[i]);
+            if (ok) ok[i] = r;
+            n += r;
+        }
+        decoded.fetch_add(n, std::memory_order_relaxed);
+    });
+    return decoded.load();
+}
+
+// Structure-of-arrays output; columns are resized to count rows up front
+template <typename T>
+size_t deserialize_batch(ThreadPool& pool, const Span* payloads, size_t count, SoA<T>& out,
+                         uint8_t* ok = nullptr) {
+    out.resize(count);
+    std::atomic<size_t> decoded{0};
+    pool.parallel_for(count, kBatchGrain, [&](size_t begin, size_t end) {
+        size_t n = 0;
+        for (size_t i = begin; i < end; i++) {
+            T obj{};
+            bool r = deserialize(payloads[i].data, payloads[i].len, obj);
+            if (r) out.set(i, obj);
+            if (ok) ok[i] = r;
+            n += r;
+        }
+        decoded.fetch_add(n, std::memory_order_relaxed);
+    });
+    return decoded.load();
+}
+
+template <typename T>
+size_t deserialize_batch(const std::vector<Span>& payloads, std::vector<T>& out) {
+    out.resize(payloads.size());
+    return deserialize_batch(default_pool(), payloads.data(), payloads.size(), out.data());
+}
+
+template <typename T>
+size_t deserialize_batch(const std::vector<Span>& payloads, SoA<T>& out) {
+    return deserialize_batch(default_pool(), payloads.data(), payloads.size(), out);
+}
+
+}  // namespace cdr
@@ -0,0 +1,349 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * CDR golden corpus conformance and throughput check (C++ codec)
+ *
+ * Every case is a message type with fixed values, defined identically in
+ * rust/src/bin/cdr_corpus.rs and python/corpus.py. For each case the encoded message
+ * must equal corpus/<case>.cdr byte for byte, and decoding the golden file
+ * then re-encoding it must reproduce it. Throughput is measured for both
+ * directions.
+ *
+ * Output is one CSV row per case, as consumed by corpus/compare.py:
+ *   lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cdr.hpp"
+#include "dynamic_cdr.hpp"
+#include "msg.hpp"
+
+// ==================== Corpus Types ====================
+
+// Padding before every field wider than the previous one
+struct Alignment {
+    uint8_t a;
+    double b;
+    uint8_t c;
+    uint16_t d;
+    uint8_t e;
+    uint32_t f;
+    bool g;
+    int64_t h;
+    int8_t i;
+    float j;
+    uint8_t k;
+};
+
+struct Limits {
+    int8_t i8_min;
+    uint8_t u8_max;
+    int16_t i16_min;
+    uint16_t u16_max;
+    int32_t i32_min;
+    uint32_t u32_max;
+    int64_t i64_min;
+    uint64_t u64_max;
+    float f32_max;
+    float f32_inf;
+    double f64_neg_zero;
+    double f64_denorm;
+};
+
+struct Strings {
+    std::string empty;
+    uint8_t a;
+    std::string odd;
+    double b;
+    std::string utf8;
+    uint16_t c;
+    std::vector<std::string> names;
+};
+
+struct WStrings {
+    uint8_t a;
+    std::u16string text;
+    uint8_t b;
+    std::u16string empty;
+    uint32_t c;
+};
+
+struct Point {
+    double x;
+    double y;
+    double z;
+};
+
+struct NestedSequences {
+    std::vector<std::vector<int16_t>> grid;
+    uint8_t tag;
+    std::vector<Point> points;
+    std::vector<std::vector<std::string>> words;
+    std::vector<double> empty;
+    uint8_t tail;
+    std::vector<uint8_t> bytes;
+};
+
+struct LargeArrays {
+    uint8_t head;
+    std::array<float, 1024> samples;
+    std::vector<double> series;
+    std::vector<uint8_t> blob;
+};
+
+// ==================== Corpus Values ====================
+
+Alignment make_alignment() {
+    return {0x11, -1.5, 0x22, 0x3344, 0x55, 0x66778899, true, -0x0102030405060708, -7, 3.25f, 0x77};
+}
+
+Limits make_limits() {
+    return {std::numeric_limits<int8_t>::min(),   std::numeric_limits<uint8_t>::max(),
+            std::numeric_limits<int16_t>::min(),  std::numeric_limits<uint16_t>::max(),
+            std::numeric_limits<int32_t>::min(),  std::numeric_limits<uint32_t>::max(),
+            std::numeric_limits<int64_t>::min(),  std::numeric_limits<uint64_t>::max(),
+            std::numeric_limits<float>::max(),    std::numeric_limits<float>::infinity(),
+            -0.0,                                 std::numeric_limits<double>::denorm_min()};
+}
+
+Strings make_strings() {
+    return {"", 0x01, "abc", 2.5, "héllo wörld ✓", 0xbeef, {"", "x", "yz"}};
+}
+
+WStrings make_wstrings() {
+    return {0x01, u"wide ✓ \U0001F600", 0x02, u"", 0xcafef00d};
+}
+
+NestedSequences make_nested_sequences() {
+    return {{{}, {1}, {2, -3, 4}},
+            0x7f,
+            {{1.0, 2.0, 3.0}, {-0.5, 0.25, 8.0}, {0.0, 0.0, -1.0}},
+            {{"a", "bc"}, {}, {"def"}},
+            {},
+            0x80,
+            {1, 2, 3, 4, 5}};
+}
+
+LargeArrays make_large_arrays() {
+    LargeArrays m{};
+    m.head = 0x42;
+    for (size_t i = 0; i < m.samples.size(); i++) m.samples[i] = i * 0.25f;
+    m.series.resize(4096);
+    for (size_t i = 0; i < m.series.size(); i++) m.series[i] = i * 0.5 - 1000.0;
+    m.blob.resize(16384);
+    for (size_t i = 0; i < m.blob.size(); i++) m.blob[i] = static_cast<uint8_t>(i * 7);
+    return m;
+}
+
+msg::Twist make_twist() { return {{1.5, -2.25, 0.0}, {0.0, 0.0, 0.75}}; }
+
+// ==================== Cases ====================
+
+struct Case {
+    std::string name;
+    std::function<std::vector<uint8_t>()> encode;
+    // Decode data; on success re-encode the decoded message into out
+    std::function<bool(const uint8_t*, size_t, std::vector<uint8_t>*)> decode;
+};
+
+template <typename T>
+Case make_case(const std::string& name, T value) {
+    auto msg = std::make_shared<T>(std::move(value));
+    return {name, [msg] { return cdr::serialize(*msg); },
+            [](const uint8_t* data, size_t len, std::vector<uint8_t>* out) {
+                T decoded{};
+                if (!cdr::deserialize(data, len, decoded)) return false;
+                if (out) *out = cdr::serialize(decoded);
+                return true;
+            }};
+}
+
+std::vector<Case> all_cases() {
+    return {make_case("alignment", make_alignment()),
+            make_case("limits", make_limits()),
+            make_case("strings", make_strings()),
+            make_case("wstring", make_wstrings()),
+            make_case("nested_sequences", make_nested_sequences()),
+            make_case("large_arrays", make_large_arrays()),
+            make_case("twist", make_twist())};
+}
+
+// ==================== Runtime Codec ====================
+
+// The Strings case as a .msg definition for dynamic_cdr.hpp
+const char* kStringsMsg =
+    "string empty\n"
+    "uint8 a\n"
+    "string odd\n"
+    "float64 b\n"
+    "string utf8\n"
+    "uint16 c\n"
+    "string[] names\n";
+
+// Decode the golden Strings file into columns and encode it back. Every truncated copy must
+// fail to decode and leave the columns unchanged. Returns an error, or "" if all checks pass
+std::string check_dynamic_columns(const std::vector<uint8_t>& golden) {
+    namespace dyn = cdr::dynamic;
+    dyn::Registry registry;
+    dyn::Plan plan;
+    std::string error;
+    if (!registry.add("corpus/Strings", kStringsMsg, &error) ||
+        !dyn::compile(registry, "corpus/Strings", plan, &error)) {
+        return error;
+    }
+
+    dyn::Columns columns(plan);
+    if (!dyn::decode(plan, golden.data(), golden.size(), columns)) return "decode_error";
+
+    auto sizes = [&columns] {
+        std::vector<size_t> out{columns.rows};
+        for (const auto& c : columns.columns) {
+            out.push_back(c.values.size());
+            out.push_back(c.offsets.size());
+        }
+        return out;
+    };
+    auto before = sizes();
+    for (size_t len = 0; len < golden.size(); len++) {
+        if (dyn::decode(plan, golden.data(), len, columns)) return "truncated_decoded";
+        if (sizes() != before) return "truncated_changed_columns";
+    }
+
+    if (!dyn::decode(plan, golden.data(), golden.size(), columns)) return "decode_error";
+    dyn::ColumnCursor cursor(columns);
+    for (size_t row = 0; row < columns.rows; row++) {
+        std::vector<uint8_t> reencoded;
+        if (!dyn::encode(plan, columns, cursor, reencoded)) return "encode_error";
+        if (reencoded != golden) return "roundtrip_mismatch";
+    }
+    return "";
+}
+
+// ==================== Benchmark ====================
+
+// Run op in doubling batches until min_seconds have elapsed; returns ns per op
+template <typename F>
+double ns_per_op(double min_seconds, F&& op) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    auto min_time = std::chrono::duration<double>(min_seconds);
+    size_t count = 0;
+    for (size_t batch = 1; clock::now() - start < min_time; batch *= 2) {
+        for (size_t i = 0; i < batch; i++) op();
+        count += batch;
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    return count ? elapsed / count : 0;
+}
+
+bool read_file(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool write_file(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <corpus_dir> [min_seconds] [--write]" << std::endl;
+    std::cout << "  --write  Regenerate the golden files from this codec" << std::endl;
+    std::cout << "Example: " << prog << " ../corpus 0.2" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Error: Corpus directory must be specified" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    std::string dir = argv[1];
+    double min_seconds = 0.2;
+    bool write = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0) {
+            write = true;
+        } else {
+            min_seconds = std::atof(argv[i]);
+        }
+    }
+
+    auto cases = all_cases();
+
+    if (write) {
+        for (const auto& c : cases) {
+            std::string path = dir + "/" + c.name + ".cdr";
+            auto data = c.encode();
+            if (!write_file(path, data)) {
+                std::cerr << "Failed to write " << path << std::endl;
+                return 1;
+            }
+            std::cout << "Wrote " << path << " (" << data.size() << " bytes)" << std::endl;
+        }
+        return 0;
+    }
+
+    std::cout << "lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s" << std::endl;
+
+    int failures = 0;
+    for (const auto& c : cases) {
+        std::vector<uint8_t> golden, reencoded;
+        std::string result = "ok";
+        if (!read_file(dir + "/" + c.name + ".cdr", golden)) {
+            result = "missing";
+        } else if (c.encode() != golden) {
+            result = "encode_mismatch";
+        } else if (!c.decode(golden.data(), golden.size(), &reencoded)) {
+            result = "decode_error";
+        } else if (reencoded != golden) {
+            result = "roundtrip_mismatch";
+        }
+
+        if (result != "ok") {
+            failures++;
+            std::cout << "cpp," << c.name << "," << result << "," << golden.size() << ",,,,"
+                      << std::endl;
+            continue;
+        }
+
+        size_t sink = 0;
+        double encode_ns = ns_per_op(min_seconds, [&] { sink += c.encode().size(); });
+        double decode_ns =
+            ns_per_op(min_seconds, [&] { sink += c.decode(golden.data(), golden.size(), NULL); });
+        if (sink == 0) std::cerr << "Benchmark produced no output" << std::endl;
+
+        double mb = golden.size() / 1e6;
+        std::cout << "cpp," << c.name << "," << result << "," << golden.size() << ","
+                  << encode_ns << "," << decode_ns << "," << mb / (encode_ns / 1e9) << ","
+                  << mb / (decode_ns / 1e9) << std::endl;
+    }
+
+    // Not a row of the table: the other codecs have no runtime codec to compare
+    std::vector<uint8_t> strings;
+    if (read_file(dir + "/strings.cdr", strings)) {
+        std::string error = check_dynamic_columns(strings);
+        if (!error.empty()) {
+            failures++;
+            std::cerr << "Runtime codec (dynamic_cdr.hpp) columns check failed: " << error
+                      << std::endl;
+        }
+    }
+    return failures ? 1 : 0;
+}
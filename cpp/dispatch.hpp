@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+/**
+ * Key expression -> handler dispatch table
+ *
+ * Routes samples from a single wildcard subscriber covering a whole
+ * namespace (e.g. robot1/ followed by **) to per-topic handlers. Each route
+ * carries its own CDR decode function, so different message types can share
+ * one receive path.
+ *
+ * Routes are registered up front; the table then only does one hash lookup
+ * on the sample key per message (no key parsing or splitting).
+ *
+ * Usage:
+ *   dispatch::Table table;
+ *   table.add<msg::Twist>("robot1/cmd_vel", [](const msg::Twist& t) { ... });
+ *   table.dispatch(key, key_len, data, len);
+ */
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cdr.hpp"
+
+namespace dispatch {
+
+class Table {
+   public:
+    using RawHandler = std::function<void(const uint8_t*, size_t)>;
+
+    // Register a typed handler; the payload is decoded as T before the callback runs
+    template <typename T>
+    void add(const std::string& key, std::function<void(const T&)> callback) {
+        add_raw(key, [callback = std::move(callback)](const uint8_t* data, size_t len) {
+            T obj{};
+            if (cdr::deserialize(data, len, obj)) callback(obj);
+        });
+    }
+
+    // Register a handler that receives the raw CDR payload
+    void add_raw(const std::string& key, RawHandler handler) {
+        auto it = routes_.find(key);
+        if (it != routes_.end()) {
+            it->second = std::move(handler);
+            return;
+        }
+        // Keys are stored in a deque so the string_view map keys stay valid
+        keys_.push_back(key);
+        routes_.emplace(std::string_view(keys_.back()), std::move(handler));
+    }
+
+    // Handler for samples whose key has no route (optional)
+    void set_fallback(std::function<void(std::string_view)> fallback) {
+        fallback_ = std::move(fallback);
+    }
+
+    // Route one sample; returns false if no handler matched the key
+    bool dispatch(const char* key, size_t key_len, const uint8_t* data, size_t len) const {
+        auto it = routes_.find(std::string_view(key, key_len));
+        if (it == routes_.end()) {
+            if (fallback_) fallback_(std::string_view(key, key_len));
+            return false;
+        }
+        it->second(data, len);
+        return true;
+    }
+
+    size_t size() const { return routes_.size(); }
+
+   private:
+    std::deque<std::string> keys_;
+    std::unordered_map<std::string_view, RawHandler> routes_;
+    std::function<void(std::string_view)> fallback_;
+};
+
+}  // namespace dispatch
@@ -0,0 +1,1380 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+/**
+ * Runtime schema-driven CDR codec
+ *
+ * For ROS2 types only known at runtime (monitoring, generic bridging).
+ * A type is described by .msg text, compiled once into a flat Plan and then
+ * executed per message without recursing over the type description:
+ *   - Consecutive fixed-size fields (including nested structs and fixed
+ *     primitive arrays) are merged into one Run with precomputed offsets,
+ *     so the whole run needs a single bounds check
+ *   - Alignment is resolved at compile time wherever the stream position is
+ *     statically known; Align steps are only emitted where it is not
+ *   - Primitive sequences are decoded with one memcpy
+ *   - Sequences / arrays of complex elements become ListBegin/ListEnd loops
+ *
+ * A plan decodes to / encodes from either a generic Value tree or Columns
+ * (one buffer per leaf field, Arrow-style offsets for variable-length data).
+ * Byte layout matches cdr::Writer / cdr::Reader.
+ *
+ * The Registry must outlive Plans compiled from it and Values decoded with them.
+ *
+ * Usage:
+ *   cdr::dynamic::Registry registry;
+ *   registry.add("geometry_msgs/Vector3", "float64 x\nfloat64 y\nfloat64 z\n");
+ *   registry.add("geometry_msgs/Twist", "Vector3 linear\nVector3 angular\n");
+ *
+ *   cdr::dynamic::Plan plan;
+ *   cdr::dynamic::compile(registry, "geometry_msgs/Twist", plan);
+ *
+ *   cdr::dynamic::Value value;
+ *   cdr::dynamic::decode(plan, data, len, value);
+ *   double x = value.field("linear")->field("x")->as<double>();
+ *
+ *   std::vector<uint8_t> out;
+ *   cdr::dynamic::encode(plan, value, out);
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cdr {
+namespace dynamic {
+
+// ==================== Type Description ====================
+
+enum class Prim : uint8_t {
+    Bool,
+    Byte,
+    Char,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64,
+};
+
+inline size_t prim_size(Prim p) {
+    switch (p) {
+        case Prim::Int16:
+        case Prim::UInt16:
+            return 2;
+        case Prim::Int32:
+        case Prim::UInt32:
+        case Prim::Float32:
+            return 4;
+        case Prim::Int64:
+        case Prim::UInt64:
+        case Prim::Float64:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
+inline bool parse_prim(std::string_view name, Prim& out) {
+    static const std::pair<const char*, Prim> kPrims[] = {
+        {"bool", Prim::Bool},       {"byte", Prim::Byte},       {"char", Prim::Char},
+        {"int8", Prim::Int8},       {"uint8", Prim::UInt8},     {"int16", Prim::Int16},
+        {"uint16", Prim::UInt16},   {"int32", Prim::Int32},     {"uint32", Prim::UInt32},
+        {"int64", Prim::Int64},     {"uint64", Prim::UInt64},   {"float32", Prim::Float32},
+        {"float64", Prim::Float64},
+    };
+    for (const auto& p : kPrims) {
+        if (name == p.first) {
+            out = p.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct FieldType {
+    enum Kind : uint8_t { Primitive, String, WString, Nested } kind = Primitive;
+    enum Array : uint8_t { None, Fixed, Sequence } array = None;
+    Prim prim = Prim::UInt8;
+    uint32_t size = 0;   // Fixed array length
+    std::string nested;  // Nested type name as written in the .msg
+};
+
+struct Field {
+    std::string name;
+    FieldType type;
+};
+
+struct MessageDef {
+    std::string name;  // "package/Type"
+    std::vector<Field> fields;
+};
+
+// "pkg/msg/Type" -> "pkg/Type"
+inline std::string normalize_name(const std::string& name) {
+    auto pos = name.find("/msg/");
+    if (pos == std::string::npos) return name;
+    return name.substr(0, pos) + name.substr(pos + 4);
+}
+
+inline std::string package_of(const std::string& name) {
+    auto pos = name.find('/');
+    return pos == std::string::npos ? std::string() : name.substr(0, pos);
+}
+
+class Registry {
+   public:
+    // Parse .msg text; constants and default values are accepted and ignored
+    bool add(const std::string& name, const std::string& definition, std::string* error = nullptr) {
+        MessageDef def;
+        def.name = normalize_name(name);
+
+        std::istringstream in(definition);
+        std::string line;
+        int lineno = 0;
+        while (std::getline(in, line)) {
+            lineno++;
+            auto hash = line.find('#');
+            if (hash != std::string::npos) line.resize(hash);
+
+            std::istringstream tokens(line);
+            std::string type, rest;
+            if (!(tokens >> type)) continue;
+            std::getline(tokens, rest);
+
+            size_t i = rest.find_first_not_of(" \t");
+            if (i == std::string::npos) {
+                return fail(error,
+                            def.name + ":" + std::to_string(lineno) + ": missing field name");
+            }
+            size_t j = rest.find_first_of(" \t=", i);
+            std::string field_name = rest.substr(i, j == std::string::npos ? j : j - i);
+            size_t k = (j == std::string::npos) ? j : rest.find_first_not_of(" \t", j);
+            if (k != std::string::npos && rest[k] == '=') continue;  // Constant
+
+            Field field;
+            field.name = field_name;
+            if (!parse_type(type, field.type)) {
+                return fail(error, def.name + ":" + std::to_string(lineno) +
+                                       ": unsupported type '" + type + "'");
+            }
+            def.fields.push_back(std::move(field));
+        }
+        if (def.fields.empty()) {
+            // Empty ROS2 messages carry one dummy byte on the wire
+            Field dummy;
+            dummy.name = "structure_needs_at_least_one_member";
+            def.fields.push_back(dummy);
+        }
+        defs_[def.name] = std::move(def);
+        return true;
+    }
+
+    // Load a .msg file; the type name is taken from ".../<package>/msg/<Type>.msg"
+    bool load(const std::string& path, std::string* error = nullptr) {
+        std::ifstream file(path);
+        if (!file) return fail(error, "cannot open " + path);
+        std::stringstream content;
+        content << file.rdbuf();
+
+        std::string stem = path.substr(path.find_last_of('/') + 1);
+        stem = stem.substr(0, stem.rfind('.'));
+        std::string name = stem;
+        auto msg_dir = path.rfind("/msg/");
+        if (msg_dir != std::string::npos) {
+            auto pkg_start = path.rfind('/', msg_dir - 1);
+            pkg_start = (pkg_start == std::string::npos) ? 0 : pkg_start + 1;
+            name = path.substr(pkg_start, msg_dir - pkg_start) + "/" + stem;
+        }
+        return add(name, content.str(), error);
+    }
+
+    // Resolve a type reference from within `context` (a message name)
+    const MessageDef* find(const std::string& name, const std::string& context = "") const {
+        std::string full = normalize_name(name);
+        auto it = defs_.find(full);
+        if (it != defs_.end()) return &it->second;
+        if (full.find('/') != std::string::npos) return nullptr;
+
+        // Unqualified: same package first, then a unique short-name match
+        std::string pkg = package_of(context);
+        if (!pkg.empty()) {
+            it = defs_.find(pkg + "/" + full);
+            if (it != defs_.end()) return &it->second;
+        }
+        const MessageDef* match = nullptr;
+        for (const auto& d : defs_) {
+            auto slash = d.first.rfind('/');
+            std::string short_name =
+                slash == std::string::npos ? d.first : d.first.substr(slash + 1);
+            if (short_name == full) {
+                if (match) return nullptr;  // Ambiguous
+                match = &d.second;
+            }
+        }
+        return match;
+    }
+
+   private:
+    static bool fail(std::string* error, const std::string& msg) {
+        if (error) *error = msg;
+        return false;
+    }
+
+    static bool parse_type(std::string type, FieldType& out) {
+        auto bracket = type.find('[');
+        if (bracket != std::string::npos) {
+            std::string suffix = type.substr(bracket + 1);
+            type.resize(bracket);
+            if (suffix.empty() || suffix.back() != ']') return false;
+            suffix.pop_back();
+            if (suffix.empty() || suffix.rfind("<=", 0) == 0) {
+                out.array = FieldType::Sequence;  // Bounded sequences share the wire format
+            } else {
+                out.array = FieldType::Fixed;
+                out.size = 0;
+                for (char c : suffix) {
+                    if (c < '0' || c > '9') return false;
+                    out.size = out.size * 10 + static_cast<uint32_t>(c - '0');
+                }
+            }
+        }
+
+        // Bounded strings (string<=N) share the wire format of string
+        std::string base = type.substr(0, type.find("<="));
+        if (base == "string") {
+            out.kind = FieldType::String;
+        } else if (base == "wstring") {
+            out.kind = FieldType::WString;
+        } else if (parse_prim(base, out.prim)) {
+            out.kind = FieldType::Primitive;
+        } else if (!base.empty()) {
+            out.kind = FieldType::Nested;
+            out.nested = base;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    std::unordered_map<std::string, MessageDef> defs_;
+};
+
+// ==================== Plan ====================
+
+// One entry of a Run: a scalar, a fixed primitive array, or a struct boundary
+struct Slot {
+    enum Kind : uint8_t { Scalar, Array, StructBegin, StructEnd } kind;
+    Prim prim;
+    uint32_t offset;  // Byte offset from the start of the run
+    uint32_t count;   // Array length
+    uint32_t index;   // Column id (Scalar/Array) or struct def id (StructBegin)
+};
+
+struct Op {
+    enum Code : uint8_t {
+        Align,      // Pad to `align`
+        Run,        // Fixed-size block: slots [first, first + count), `bytes` long
+        String,     // uint32 length (with null) + chars
+        WString,    // uint32 length (with null) + UTF-16 units
+        PrimSeq,    // uint32 count + packed primitives
+        ListBegin,  // Fixed (`count`) or uint32 count of complex elements; body follows
+        ListEnd,    // Jump back to body start while elements remain
+    } code;
+    Prim prim = Prim::UInt8;
+    bool fixed = false;   // ListBegin: count is static
+    uint32_t align = 1;   // Align
+    uint32_t first = 0;   // Run: first slot / ListEnd: body start / ListBegin: ListEnd index
+    uint32_t count = 0;   // Run: slot count / ListBegin: fixed element count
+    uint32_t bytes = 0;   // Run: total bytes including static padding
+    uint32_t column = 0;  // String / WString / PrimSeq / ListBegin
+    uint32_t grow_first = 0;  // ListBegin: per-element column growth [grow_first, +grow_count)
+    uint32_t grow_count = 0;
+    uint32_t copy_first = 0;  // Run: column copies [copy_first, +copy_count)
+    uint32_t copy_count = 0;
+};
+
+// Bytes a fixed-layout column (Scalar/Array) gains per row, or per element of its list
+struct Growth {
+    uint32_t column;
+    uint32_t bytes;
+};
+
+// One Scalar/Array slot of a Run, flattened for columnar decode (struct markers dropped)
+struct Copy {
+    uint32_t offset;  // Byte offset from the start of the run
+    uint32_t column;
+    uint32_t bytes;
+    bool scalar;  // Single 1/2/4/8-byte value
+};
+
+struct ColumnInfo {
+    enum Kind : uint8_t { Scalar, Array, Sequence, String, WString, List } kind;
+    Prim prim;
+    uint32_t count;    // Array length
+    std::string path;  // e.g. "linear.x", "points.x"
+};
+
+// Maximum nesting of structs and lists; bounds the executors' fixed-size stacks
+constexpr int kMaxDepth = 64;
+
+struct Plan {
+    const MessageDef* root = nullptr;
+    std::vector<Op> ops;
+    std::vector<Slot> slots;
+    std::vector<const MessageDef*> defs;
+    std::vector<ColumnInfo> columns;
+    std::vector<Growth> growth;  // Per-row entries first, then per-list (see Op::grow_first)
+    uint32_t row_growth = 0;     // Number of per-row entries
+    std::vector<Copy> copies;    // See Op::copy_first
+};
+
+namespace detail {
+
+// Static knowledge of the stream position: pos % mod == rem
+struct AlignState {
+    uint32_t mod = 8;
+    uint32_t rem = 0;
+    bool operator==(const AlignState& o) const { return mod == o.mod && rem == o.rem; }
+};
+
+inline AlignState meet(AlignState a, AlignState b) {
+    uint32_t m = a.mod < b.mod ? a.mod : b.mod;
+    while (m > 1 && a.rem % m != b.rem % m) m /= 2;
+    return {m, a.rem % m};
+}
+
+class Compiler {
+   public:
+    Compiler(const Registry& registry, Plan& plan, std::string* error)
+        : registry_(registry), plan_(plan), error_(error) {}
+
+    bool compile_root(const MessageDef& def) {
+        if (!compile_fields(def, "", 0)) return false;
+        close_run();
+        return true;
+    }
+
+   private:
+    bool compile_fields(const MessageDef& def, const std::string& prefix, int depth) {
+        if (depth >= kMaxDepth - 1) return fail("type nesting too deep at " + def.name);
+        for (const auto& field : def.fields) {
+            std::string path = prefix.empty() ? field.name : prefix + "." + field.name;
+            if (!compile_field(def, field, path, depth)) return false;
+        }
+        return true;
+    }
+
+    bool compile_field(const MessageDef& owner, const Field& field, const std::string& path,
+                       int depth) {
+        const FieldType& t = field.type;
+        const MessageDef* nested = nullptr;
+        if (t.kind == FieldType::Nested) {
+            nested = registry_.find(t.nested, owner.name);
+            if (!nested) return fail("unknown type '" + t.nested + "' in " + owner.name);
+        }
+
+        if (t.kind == FieldType::Primitive) {
+            if (t.array == FieldType::None) {
+                add_slot(Slot::Scalar, t.prim, 0, column(ColumnInfo::Scalar, t.prim, 0, path));
+            } else if (t.array == FieldType::Fixed) {
+                add_slot(Slot::Array, t.prim, t.size,
+                         column(ColumnInfo::Array, t.prim, t.size, path));
+            } else {
+                close_run();
+                Op op{Op::PrimSeq};
+                op.prim = t.prim;
+                op.column = column(ColumnInfo::Sequence, t.prim, 0, path);
+                plan_.ops.push_back(op);
+                uint32_t s = static_cast<uint32_t>(prim_size(t.prim));
+                state_ = {s < 4 ? s : 4, 0};
+            }
+            return true;
+        }
+
+        if (t.array == FieldType::None) return compile_single(t, nested, path, depth);
+
+        // Array / sequence of strings or structs: loop over a compiled body
+        close_run();
+        bool fixed = t.array == FieldType::Fixed;
+        if (fixed && t.size == 0) return true;
+
+        AlignState before = fixed ? state_ : AlignState{4, 0};
+        Op begin{Op::ListBegin};
+        begin.fixed = fixed;
+        begin.count = t.size;
+        begin.column = column(ColumnInfo::List, Prim::UInt8, 0, path);
+        size_t begin_pc = plan_.ops.size();
+        size_t slots_mark = plan_.slots.size();
+        size_t defs_mark = plan_.defs.size();
+        size_t columns_mark = plan_.columns.size();
+
+        // Find an entry state that holds for every iteration (converges: mod only shrinks)
+        AlignState entry = before;
+        AlignState exit;
+        for (;;) {
+            plan_.ops.resize(begin_pc);
+            plan_.slots.resize(slots_mark);
+            plan_.defs.resize(defs_mark);
+            plan_.columns.resize(columns_mark);
+            plan_.ops.push_back(begin);
+
+            state_ = entry;
+            if (!compile_single(t, nested, path, depth + 1)) return false;
+            close_run();
+            exit = state_;
+            AlignState merged = meet(entry, exit);
+            if (merged == entry) break;
+            entry = merged;
+        }
+
+        Op end{Op::ListEnd};
+        end.first = static_cast<uint32_t>(begin_pc + 1);
+        plan_.ops[begin_pc].first = static_cast<uint32_t>(plan_.ops.size());
+        plan_.ops.push_back(end);
+        state_ = fixed ? exit : meet(before, exit);
+        return true;
+    }
+
+    bool compile_single(const FieldType& t, const MessageDef* nested, const std::string& path,
+                        int depth) {
+        if (t.kind == FieldType::String || t.kind == FieldType::WString) {
+            close_run();
+            bool wide = t.kind == FieldType::WString;
+            Op op{wide ? Op::WString : Op::String};
+            op.column = column(wide ? ColumnInfo::WString : ColumnInfo::String, Prim::UInt8, 0,
+                               path);
+            plan_.ops.push_back(op);
+            state_ = {wide ? 2u : 1u, 0};
+            return true;
+        }
+        uint32_t def_id = static_cast<uint32_t>(plan_.defs.size());
+        plan_.defs.push_back(nested);
+        add_marker(Slot::StructBegin, def_id);
+        if (!compile_fields(*nested, path, depth + 1)) return false;
+        add_marker(Slot::StructEnd, 0);
+        return true;
+    }
+
+    uint32_t column(ColumnInfo::Kind kind, Prim prim, uint32_t count, const std::string& path) {
+        plan_.columns.push_back({kind, prim, count, path});
+        return static_cast<uint32_t>(plan_.columns.size() - 1);
+    }
+
+    void add_marker(Slot::Kind kind, uint32_t index) {
+        open_run();
+        plan_.slots.push_back({kind, Prim::UInt8, run_bytes_, 0, index});
+    }
+
+    void add_slot(Slot::Kind kind, Prim prim, uint32_t count, uint32_t col) {
+        uint32_t a = static_cast<uint32_t>(prim_size(prim));
+        uint32_t n = (kind == Slot::Array) ? count : 1;
+        if (n == 0) {
+            open_run();
+            plan_.slots.push_back({kind, prim, run_bytes_, count, col});
+            return;
+        }
+        if (a > state_.mod) {
+            // Position not statically known: end the run and align at runtime. A run holding
+            // only struct markers so far stays open and simply starts after the Align.
+            if (run_bytes_ > 0) close_run();
+            Op op{Op::Align};
+            op.align = a;
+            plan_.ops.push_back(op);
+            state_ = {a, 0};
+        }
+        open_run();
+        uint32_t pad = (a - state_.rem % a) % a;
+        plan_.slots.push_back({kind, prim, run_bytes_ + pad, count, col});
+        run_bytes_ += pad + a * n;
+        state_.rem = (state_.rem + pad + a * n) % state_.mod;
+    }
+
+    void open_run() {
+        if (run_open_) return;
+        run_open_ = true;
+        run_first_ = static_cast<uint32_t>(plan_.slots.size());
+        run_bytes_ = 0;
+    }
+
+    void close_run() {
+        if (!run_open_) return;
+        run_open_ = false;
+        Op op{Op::Run};
+        op.first = run_first_;
+        op.count = static_cast<uint32_t>(plan_.slots.size()) - run_first_;
+        op.bytes = run_bytes_;
+        plan_.ops.push_back(op);
+    }
+
+    bool fail(const std::string& msg) {
+        if (error_) *error_ = msg;
+        return false;
+    }
+
+    const Registry& registry_;
+    Plan& plan_;
+    std::string* error_;
+    AlignState state_;
+    bool run_open_ = false;
+    uint32_t run_first_ = 0;
+    uint32_t run_bytes_ = 0;
+};
+
+}  // namespace detail
+
+namespace detail {
+
+// Group fixed-layout columns by the loop that fills them, so columnar decode can size
+// each column once per row (or once per list) and then write through a pointer
+inline void compute_growth(Plan& plan) {
+    std::vector<std::vector<Growth>> owned(plan.ops.size() + 1);  // Last entry: row level
+    std::vector<size_t> loops{plan.ops.size()};
+    for (size_t pc = 0; pc < plan.ops.size(); pc++) {
+        Op& op = plan.ops[pc];
+        if (op.code == Op::ListBegin) {
+            loops.push_back(pc);
+        } else if (op.code == Op::ListEnd) {
+            loops.pop_back();
+        } else if (op.code == Op::Run) {
+            op.copy_first = static_cast<uint32_t>(plan.copies.size());
+            for (uint32_t i = op.first; i < op.first + op.count; i++) {
+                const Slot& s = plan.slots[i];
+                if (s.kind != Slot::Scalar && s.kind != Slot::Array) continue;
+                uint32_t size = static_cast<uint32_t>(prim_size(s.prim));
+                uint32_t bytes = (s.kind == Slot::Scalar) ? size : size * s.count;
+                owned[loops.back()].push_back({s.index, bytes});
+                plan.copies.push_back({s.offset, s.index, bytes, s.kind == Slot::Scalar});
+            }
+            op.copy_count = static_cast<uint32_t>(plan.copies.size()) - op.copy_first;
+        }
+    }
+    plan.growth = owned.back();
+    plan.row_growth = static_cast<uint32_t>(plan.growth.size());
+    for (size_t pc = 0; pc < plan.ops.size(); pc++) {
+        if (plan.ops[pc].code != Op::ListBegin) continue;
+        plan.ops[pc].grow_first = static_cast<uint32_t>(plan.growth.size());
+        plan.ops[pc].grow_count = static_cast<uint32_t>(owned[pc].size());
+        plan.growth.insert(plan.growth.end(), owned[pc].begin(), owned[pc].end());
+    }
+}
+
+}  // namespace detail
+
+// Compile `type_name` (and every type it references) into plan
+inline bool compile(const Registry& registry, const std::string& type_name, Plan& plan,
+                    std::string* error = nullptr) {
+    plan = Plan();
+    plan.root = registry.find(type_name);
+    if (!plan.root) {
+        if (error) *error = "unknown type '" + type_name + "'";
+        return false;
+    }
+    detail::Compiler compiler(registry, plan, error);
+    if (!compiler.compile_root(*plan.root)) return false;
+    detail::compute_growth(plan);
+    return true;
+}
+
+// ==================== Value Tree ====================
+
+struct Value {
+    enum Kind : uint8_t { Struct, Scalar, Array, String, WString, List } kind = Struct;
+    Prim prim = Prim::UInt8;          // Scalar / Array element type
+    uint64_t bits = 0;                // Scalar, native little endian bytes
+    std::string str;                  // String
+    std::u16string wstr;              // WString
+    std::vector<uint8_t> data;        // Array (fixed or sequence): packed elements
+    std::vector<Value> items;         // Struct fields / List elements
+    const MessageDef* def = nullptr;  // Struct
+
+    template <typename T>
+    T as() const {
+        T v{};
+        memcpy(&v, &bits, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+        return v;
+    }
+    template <typename T>
+    void set(T v) {
+        bits = 0;
+        memcpy(&bits, &v, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+    }
+
+    // Array elements
+    size_t array_size() const { return data.size() / prim_size(prim); }
+    template <typename T>
+    const T* array_data() const {
+        return reinterpret_cast<const T*>(data.data());
+    }
+
+    const Value* field(std::string_view name) const {
+        if (kind != Struct || !def) return nullptr;
+        for (size_t i = 0; i < def->fields.size() && i < items.size(); i++) {
+            if (def->fields[i].name == name) return &items[i];
+        }
+        return nullptr;
+    }
+    Value* field(std::string_view name) {
+        return const_cast<Value*>(static_cast<const Value&>(*this).field(name));
+    }
+};
+
+// ==================== Columns ====================
+
+namespace detail {
+class ColumnSink;
+}  // namespace detail
+
+// Append-only bytes. grow() is inline and does not zero-fill, so decoders can reserve a
+// row's worth of space and write through the returned pointer.
+class ByteBuffer {
+   public:
+    const uint8_t* data() const { return storage_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint8_t operator[](size_t i) const { return storage_[i]; }
+
+    void clear() { size_ = 0; }
+    // Drop bytes past n (n <= size())
+    void truncate(size_t n) { size_ = n; }
+    void reserve(size_t n) {
+        if (n > storage_.size()) storage_.resize(n);
+    }
+
+    // Extend by n bytes and return a pointer to them (contents unspecified)
+    uint8_t* grow(size_t n) {
+        if (size_ + n > storage_.size()) storage_.resize(std::max(storage_.size() * 2, size_ + n));
+        uint8_t* p = storage_.data() + size_;
+        size_ += n;
+        return p;
+    }
+    void append(const uint8_t* data, size_t n) {
+        if (n) memcpy(grow(n), data, n);
+    }
+
+   private:
+    std::vector<uint8_t> storage_;
+    size_t size_ = 0;
+};
+
+// Arrow-style columnar storage for many messages of one type. Variable-length
+// columns (Sequence, String, WString, List) keep offsets with a leading 0.
+struct Column {
+    ColumnInfo info;
+    ByteBuffer values;
+    std::vector<uint32_t> offsets{0};
+};
+
+struct Columns {
+    std::vector<Column> columns;
+    size_t rows = 0;
+
+    explicit Columns(const Plan& plan)
+        : row_bytes_(plan.columns.size(), 0), cursors_(plan.columns.size(), nullptr) {
+        for (const auto& info : plan.columns) columns.push_back({info, {}, {0}});
+        for (uint32_t i = 0; i < plan.row_growth; i++) {
+            row_bytes_[plan.growth[i].column] = plan.growth[i].bytes;
+        }
+        for (uint32_t i = 0; i < columns.size(); i++) {
+            if (!row_bytes_[i]) marks_.push_back({i, 0, 0});
+        }
+    }
+
+    // Preallocate for `rows` more messages (exact for columns outside lists)
+    void reserve(size_t more) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            auto& c = columns[i];
+            if (row_bytes_[i]) {
+                c.values.reserve(c.values.size() + more * row_bytes_[i]);
+            } else {
+                c.offsets.reserve(c.offsets.size() + more);
+            }
+        }
+    }
+
+   private:
+    friend class detail::ColumnSink;
+    std::vector<size_t> row_bytes_;
+    std::vector<uint8_t*> cursors_;  // Write position per column while decoding
+    // Sizes before the current row of the columns that do not grow by a fixed amount per
+    // row, so a failed decode can be undone
+    struct Mark {
+        uint32_t column;
+        size_t values;
+        size_t offsets;
+    };
+    std::vector<Mark> marks_;
+};
+
+// Sequential read position into Columns, for encoding rows back in order
+struct ColumnCursor {
+    std::vector<size_t> value_pos;
+    std::vector<size_t> offset_pos;
+    explicit ColumnCursor(const Columns& cols)
+        : value_pos(cols.columns.size(), 0), offset_pos(cols.columns.size(), 0) {}
+};
+
+// ==================== Executors ====================
+
+namespace detail {
+
+// Fixed-size copies compile to single loads/stores instead of memcpy calls
+inline void copy_scalar(void* dst, const void* src, size_t size) {
+    switch (size) {
+        case 1:
+            memcpy(dst, src, 1);
+            break;
+        case 2:
+            memcpy(dst, src, 2);
+            break;
+        case 4:
+            memcpy(dst, src, 4);
+            break;
+        default:
+            memcpy(dst, src, 8);
+            break;
+    }
+}
+
+// Decodes into an existing tree, reusing its nodes and buffers, so decoding a
+// stream of messages into the same Value does not allocate in steady state
+class TreeSink {
+   public:
+    TreeSink(const Plan& plan, Value& root) : plan_(plan), root_(root) {
+        if (root.kind != Value::Struct || root.def != plan.root) root = Value();
+        root.def = plan.root;
+        stack_[0] = {&root, 0};
+    }
+
+    // Drop nodes left over from a previous, larger message
+    void finish() { root_.items.resize(stack_[0].second); }
+
+    void run(const Op& op, const uint8_t* base) {
+        for (uint32_t i = op.first; i < op.first + op.count; i++) {
+            const Slot& s = plan_.slots[i];
+            switch (s.kind) {
+                case Slot::Scalar: {
+                    Value& v = push(Value::Scalar);
+                    v.prim = s.prim;
+                    copy_scalar(&v.bits, base + s.offset, prim_size(s.prim));
+                    break;
+                }
+                case Slot::Array: {
+                    Value& v = push(Value::Array);
+                    v.prim = s.prim;
+                    v.data.assign(base + s.offset, base + s.offset + s.count * prim_size(s.prim));
+                    break;
+                }
+                case Slot::StructBegin: {
+                    Value& v = push(Value::Struct);
+                    v.def = plan_.defs[s.index];
+                    stack_[++top_] = {&v, 0};
+                    break;
+                }
+                case Slot::StructEnd:
+                    pop();
+                    break;
+            }
+        }
+    }
+    void string(const Op&, const char* data, size_t len) {
+        push(Value::String).str.assign(data, len);
+    }
+    void wstring(const Op&, const uint8_t* data, size_t units) {
+        Value& v = push(Value::WString);
+        v.wstr.resize(units);
+        if (units) memcpy(&v.wstr[0], data, units * 2);
+    }
+    void prim_seq(const Op& op, const uint8_t* data, size_t count) {
+        Value& v = push(Value::Array);
+        v.prim = op.prim;
+        v.data.assign(data, data + count * prim_size(op.prim));
+    }
+    void list_begin(const Op&, uint32_t count) {
+        Value& v = push(Value::List);
+        v.items.reserve(count);
+        stack_[++top_] = {&v, 0};
+    }
+    void list_end() { pop(); }
+
+   private:
+    Value& push(Value::Kind kind) {
+        auto& top = stack_[top_];
+        auto& items = top.first->items;
+        if (top.second == items.size()) items.emplace_back();
+        Value& v = items[top.second++];
+        if (v.kind != kind) {
+            v = Value();
+            v.kind = kind;
+        }
+        return v;
+    }
+    void pop() {
+        auto& top = stack_[top_--];
+        top.first->items.resize(top.second);
+    }
+    const Plan& plan_;
+    Value& root_;
+    struct Frame {
+        Value* first;
+        size_t second;
+    };
+    Frame stack_[kMaxDepth];
+    int top_ = 0;
+};
+
+class ColumnSink {
+   public:
+    // Sizes the row-level fixed columns for one more row up front
+    ColumnSink(const Plan& plan, Columns& cols)
+        : plan_(plan), cols_(cols), cursors_(cols.cursors_.data()) {
+        for (auto& mark : cols.marks_) {
+            mark.values = cols.columns[mark.column].values.size();
+            mark.offsets = cols.columns[mark.column].offsets.size();
+        }
+        grow(0, plan.row_growth, 1);
+    }
+
+    // Undo everything this row appended, after a failed decode
+    void rollback() {
+        for (uint32_t i = 0; i < plan_.row_growth; i++) {
+            auto& values = cols_.columns[plan_.growth[i].column].values;
+            values.truncate(values.size() - plan_.growth[i].bytes);
+        }
+        for (const auto& mark : cols_.marks_) {
+            cols_.columns[mark.column].values.truncate(mark.values);
+            cols_.columns[mark.column].offsets.resize(mark.offsets);
+        }
+    }
+
+    void run(const Op& op, const uint8_t* base) {
+        const Copy* copy = plan_.copies.data() + op.copy_first;
+        for (const Copy* end = copy + op.copy_count; copy != end; copy++) {
+            uint8_t*& cursor = cursors_[copy->column];
+            if (copy->scalar) {
+                copy_scalar(cursor, base + copy->offset, copy->bytes);
+            } else if (copy->bytes) {
+                memcpy(cursor, base + copy->offset, copy->bytes);
+            }
+            cursor += copy->bytes;
+        }
+    }
+    void string(const Op& op, const char* data, size_t len) {
+        append(op.column, reinterpret_cast<const uint8_t*>(data), len, len);
+    }
+    void wstring(const Op& op, const uint8_t* data, size_t units) {
+        append(op.column, data, units * 2, units);
+    }
+    void prim_seq(const Op& op, const uint8_t* data, size_t count) {
+        append(op.column, data, count * prim_size(op.prim), count);
+    }
+    void list_begin(const Op& op, uint32_t count) {
+        auto& offsets = cols_.columns[op.column].offsets;
+        offsets.push_back(offsets.back() + count);
+        grow(op.grow_first, op.grow_count, count);
+    }
+    void list_end() {}
+
+   private:
+    // Extend each column in growth[first, first + n) by count units; point its cursor there
+    void grow(uint32_t first, uint32_t n, size_t count) {
+        for (uint32_t i = first; i < first + n; i++) {
+            const Growth& g = plan_.growth[i];
+            cursors_[g.column] = cols_.columns[g.column].values.grow(g.bytes * count);
+        }
+    }
+    void append(uint32_t col, const uint8_t* data, size_t bytes, size_t count) {
+        auto& c = cols_.columns[col];
+        c.values.append(data, bytes);
+        c.offsets.push_back(c.offsets.back() + static_cast<uint32_t>(count));
+    }
+    const Plan& plan_;
+    Columns& cols_;
+    uint8_t** cursors_;
+};
+
+template <typename Sink>
+bool run_decode(const Plan& plan, const uint8_t* data, size_t len, Sink& sink) {
+    if (len < 4 || !plan.root) return false;
+    const uint8_t* p = data + 4;  // Skip CDR header
+    size_t n = len - 4;
+    size_t pos = 0;
+
+    struct Loop {
+        uint32_t body;
+        uint32_t remaining;
+    };
+    Loop loops[kMaxDepth];
+    int depth = 0;
+
+    auto read_u32 = [&](uint32_t& v) {
+        pos += (4 - pos % 4) % 4;
+        if (pos + 4 > n) return false;
+        memcpy(&v, p + pos, 4);
+        pos += 4;
+        return true;
+    };
+
+    const size_t end = plan.ops.size();
+    for (size_t pc = 0; pc < end;) {
+        const Op& op = plan.ops[pc];
+        switch (op.code) {
+            case Op::Align:
+                pos += (op.align - pos % op.align) % op.align;
+                pc++;
+                break;
+            case Op::Run:
+                if (pos + op.bytes > n) return false;
+                sink.run(op, p + pos);
+                pos += op.bytes;
+                pc++;
+                break;
+            case Op::String: {
+                uint32_t count;
+                if (!read_u32(count)) return false;
+                if (count > n - pos) return false;
+                // Length includes the null terminator
+                sink.string(op, reinterpret_cast<const char*>(p + pos), count ? count - 1 : 0);
+                pos += count;
+                pc++;
+                break;
+            }
+            case Op::WString: {
+                uint32_t count;
+                if (!read_u32(count)) return false;
+                if (count > (n - pos) / 2) return false;
+                sink.wstring(op, p + pos, count ? count - 1 : 0);
+                pos += size_t(count) * 2;
+                pc++;
+                break;
+            }
+            case Op::PrimSeq: {
+                uint32_t count;
+                if (!read_u32(count)) return false;
+                size_t s = prim_size(op.prim);
+                if (count > 0) pos += (s - pos % s) % s;
+                if (pos > n || count > (n - pos) / s) return false;
+                sink.prim_seq(op, p + pos, count);
+                pos += count * s;
+                pc++;
+                break;
+            }
+            case Op::ListBegin: {
+                uint32_t count = op.count;
+                if (!op.fixed && !read_u32(count)) return false;
+                if (count > n - pos + 1) return false;  // Every element takes at least a byte
+                sink.list_begin(op, count);
+                if (count == 0) {
+                    sink.list_end();
+                    pc = op.first + 1;
+                } else {
+                    loops[depth++] = {static_cast<uint32_t>(pc + 1), count};
+                    pc++;
+                }
+                break;
+            }
+            case Op::ListEnd: {
+                Loop& loop = loops[depth - 1];
+                if (--loop.remaining > 0) {
+                    pc = loop.body;
+                } else {
+                    depth--;
+                    sink.list_end();
+                    pc++;
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+class TreeSource {
+   public:
+    TreeSource(const Plan& plan, const Value& root) : plan_(plan) { stack_[0] = {&root, 0}; }
+
+    bool run(const Op& op, uint8_t* out) {
+        for (uint32_t i = op.first; i < op.first + op.count; i++) {
+            const Slot& s = plan_.slots[i];
+            if (s.kind == Slot::StructEnd) {
+                top_--;
+                continue;
+            }
+            const Value* v = next();
+            if (!v) return false;
+            switch (s.kind) {
+                case Slot::Scalar:
+                    if (v->kind != Value::Scalar) return false;
+                    memcpy(out + s.offset, &v->bits, prim_size(s.prim));
+                    break;
+                case Slot::Array:
+                    if (v->kind != Value::Array || v->data.size() != s.count * prim_size(s.prim))
+                        return false;
+                    if (!v->data.empty()) memcpy(out + s.offset, v->data.data(), v->data.size());
+                    break;
+                case Slot::StructBegin:
+                    if (v->kind != Value::Struct) return false;
+                    stack_[++top_] = {v, 0};
+                    break;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+    bool string(const Op&, const uint8_t*& data, size_t& len) {
+        const Value* v = next();
+        if (!v || v->kind != Value::String) return false;
+        data = reinterpret_cast<const uint8_t*>(v->str.data());
+        len = v->str.size();
+        return true;
+    }
+    bool wstring(const Op&, const uint8_t*& data, size_t& units) {
+        const Value* v = next();
+        if (!v || v->kind != Value::WString) return false;
+        data = reinterpret_cast<const uint8_t*>(v->wstr.data());
+        units = v->wstr.size();
+        return true;
+    }
+    bool prim_seq(const Op& op, const uint8_t*& data, size_t& count) {
+        const Value* v = next();
+        if (!v || v->kind != Value::Array) return false;
+        data = v->data.data();
+        count = v->data.size() / prim_size(op.prim);
+        return true;
+    }
+    bool list_begin(const Op& op, uint32_t& count) {
+        const Value* v = next();
+        if (!v || v->kind != Value::List) return false;
+        if (op.fixed && v->items.size() != op.count) return false;
+        count = static_cast<uint32_t>(v->items.size());
+        stack_[++top_] = {v, 0};
+        return true;
+    }
+    void list_end() { top_--; }
+
+   private:
+    const Value* next() {
+        auto& top = stack_[top_];
+        if (top.second >= top.first->items.size()) return nullptr;
+        return &top.first->items[top.second++];
+    }
+    const Plan& plan_;
+    struct Frame {
+        const Value* first;
+        size_t second;
+    };
+    Frame stack_[kMaxDepth];
+    int top_ = 0;
+};
+
+class ColumnSource {
+   public:
+    ColumnSource(const Plan& plan, const Columns& cols, ColumnCursor& cursor)
+        : plan_(plan), cols_(cols), cursor_(cursor) {}
+
+    bool run(const Op& op, uint8_t* out) {
+        for (uint32_t i = op.first; i < op.first + op.count; i++) {
+            const Slot& s = plan_.slots[i];
+            if (s.kind != Slot::Scalar && s.kind != Slot::Array) continue;
+            size_t n = prim_size(s.prim) * (s.kind == Slot::Array ? s.count : 1);
+            const auto& values = cols_.columns[s.index].values;
+            size_t& pos = cursor_.value_pos[s.index];
+            if (pos + n > values.size()) return false;
+            if (n) memcpy(out + s.offset, values.data() + pos, n);
+            pos += n;
+        }
+        return true;
+    }
+    bool string(const Op& op, const uint8_t*& data, size_t& len) {
+        return take(op.column, 1, data, len);
+    }
+    bool wstring(const Op& op, const uint8_t*& data, size_t& units) {
+        return take(op.column, 2, data, units);
+    }
+    bool prim_seq(const Op& op, const uint8_t*& data, size_t& count) {
+        return take(op.column, prim_size(op.prim), data, count);
+    }
+    bool list_begin(const Op& op, uint32_t& count) {
+        const auto& offsets = cols_.columns[op.column].offsets;
+        size_t& i = cursor_.offset_pos[op.column];
+        if (i + 1 >= offsets.size()) return false;
+        count = offsets[i + 1] - offsets[i];
+        i++;
+        return !op.fixed || count == op.count;
+    }
+    void list_end() {}
+
+   private:
+    bool take(uint32_t col, size_t unit, const uint8_t*& data, size_t& count) {
+        const auto& c = cols_.columns[col];
+        size_t& i = cursor_.offset_pos[col];
+        if (i + 1 >= c.offsets.size()) return false;
+        count = c.offsets[i + 1] - c.offsets[i];
+        size_t begin = size_t(c.offsets[i]) * unit;
+        if (begin + count * unit > c.values.size()) return false;
+        data = c.values.data() + begin;
+        cursor_.value_pos[col] = begin + count * unit;
+        i++;
+        return true;
+    }
+    const Plan& plan_;
+    const Columns& cols_;
+    ColumnCursor& cursor_;
+};
+
+template <typename Source>
+bool run_encode(const Plan& plan, Source& source, std::vector<uint8_t>& out) {
+    if (!plan.root) return false;
+    out.clear();
+    out.reserve(256);
+    // CDR header (little endian)
+    out.push_back(0x00);
+    out.push_back(0x01);
+    out.push_back(0x00);
+    out.push_back(0x00);
+
+    auto pos = [&out] { return out.size() - 4; };
+    auto align = [&](size_t a) { out.resize(out.size() + (a - pos() % a) % a, 0); };
+    auto write = [&out](const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), p, p + len);
+    };
+    auto write_u32 = [&](uint32_t v) {
+        align(4);
+        write(&v, 4);
+    };
+
+    struct Loop {
+        uint32_t body;
+        uint32_t remaining;
+    };
+    Loop loops[kMaxDepth];
+    int depth = 0;
+
+    const size_t end = plan.ops.size();
+    for (size_t pc = 0; pc < end;) {
+        const Op& op = plan.ops[pc];
+        switch (op.code) {
+            case Op::Align:
+                align(op.align);
+                pc++;
+                break;
+            case Op::Run: {
+                size_t at = out.size();
+                out.resize(at + op.bytes, 0);
+                if (!source.run(op, out.data() + at)) return false;
+                pc++;
+                break;
+            }
+            case Op::String: {
+                const uint8_t* data;
+                size_t len;
+                if (!source.string(op, data, len)) return false;
+                write_u32(static_cast<uint32_t>(len + 1));
+                write(data, len);
+                out.push_back(0);
+                pc++;
+                break;
+            }
+            case Op::WString: {
+                const uint8_t* data;
+                size_t units;
+                if (!source.wstring(op, data, units)) return false;
+                write_u32(static_cast<uint32_t>(units + 1));
+                write(data, units * 2);
+                out.push_back(0);
+                out.push_back(0);
+                pc++;
+                break;
+            }
+            case Op::PrimSeq: {
+                const uint8_t* data;
+                size_t count;
+                if (!source.prim_seq(op, data, count)) return false;
+                write_u32(static_cast<uint32_t>(count));
+                if (count > 0) {
+                    align(prim_size(op.prim));
+                    write(data, count * prim_size(op.prim));
+                }
+                pc++;
+                break;
+            }
+            case Op::ListBegin: {
+                uint32_t count;
+                if (!source.list_begin(op, count)) return false;
+                if (!op.fixed) write_u32(count);
+                if (count == 0) {
+                    source.list_end();
+                    pc = op.first + 1;
+                } else {
+                    loops[depth++] = {static_cast<uint32_t>(pc + 1), count};
+                    pc++;
+                }
+                break;
+            }
+            case Op::ListEnd: {
+                Loop& loop = loops[depth - 1];
+                if (--loop.remaining > 0) {
+                    pc = loop.body;
+                } else {
+                    depth--;
+                    source.list_end();
+                    pc++;
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace detail
+
+// ==================== Convenience Functions ====================
+
+// Reuses the nodes already in out, so decoding a stream into one Value is cheap
+inline bool decode(const Plan& plan, const uint8_t* data, size_t len, Value& out) {
+    detail::TreeSink sink(plan, out);
+    bool ok = detail::run_decode(plan, data, len, sink);
+    sink.finish();
+    return ok;
+}
+
+// Append one message as a new row; on failure out is left unchanged
+inline bool decode(const Plan& plan, const uint8_t* data, size_t len, Columns& out) {
+    detail::ColumnSink sink(plan, out);
+    if (!detail::run_decode(plan, data, len, sink)) {
+        sink.rollback();  // A failed row leaves out unchanged
+        return false;
+    }
+    out.rows++;
+    return true;
+}
+
+inline bool encode(const Plan& plan, const Value& value, std::vector<uint8_t>& out) {
+    detail::TreeSource source(plan, value);
+    return detail::run_encode(plan, source, out);
+}
+
+// Encode the next row at cursor
+inline bool encode(const Plan& plan, const Columns& cols, ColumnCursor& cursor,
+                   std::vector<uint8_t>& out) {
+    detail::ColumnSource source(plan, cols, cursor);
+    return detail::run_encode(plan, source, out);
+}
+
+// ==================== Printing ====================
+
+inline void print_scalar(std::ostream& os, Prim prim, const uint8_t* p) {
+    auto get = [p](auto v) {
+        memcpy(&v, p, sizeof(v));
+        return v;
+    };
+    switch (prim) {
+        case Prim::Bool:
+            os << (p[0] ? "true" : "false");
+            break;
+        case Prim::Int8:
+            os << int(get(int8_t()));
+            break;
+        case Prim::Byte:
+        case Prim::Char:
+        case Prim::UInt8:
+            os << unsigned(p[0]);
+            break;
+        case Prim::Int16:
+            os << get(int16_t());
+            break;
+        case Prim::UInt16:
+            os << get(uint16_t());
+            break;
+        case Prim::Int32:
+            os << get(int32_t());
+            break;
+        case Prim::UInt32:
+            os << get(uint32_t());
+            break;
+        case Prim::Int64:
+            os << get(int64_t());
+            break;
+        case Prim::UInt64:
+            os << get(uint64_t());
+            break;
+        case Prim::Float32:
+            os << get(float());
+            break;
+        case Prim::Float64:
+            os << get(double());
+            break;
+    }
+}
+
+// YAML-like output in the style of `ros2 topic echo`
+inline void print(std::ostream& os, const Value& v, int indent = 0) {
+    std::string pad(indent * 2, ' ');
+    switch (v.kind) {
+        case Value::Struct:
+            for (size_t i = 0; i < v.items.size(); i++) {
+                const Value& f = v.items[i];
+                os << pad << (v.def ? v.def->fields[i].name : std::to_string(i)) << ":";
+                if (f.kind == Value::Struct || f.kind == Value::List) {
+                    os << "\n";
+                    print(os, f, indent + 1);
+                } else {
+                    os << " ";
+                    print(os, f, 0);
+                    os << "\n";
+                }
+            }
+            break;
+        case Value::Scalar:
+            print_scalar(os, v.prim, reinterpret_cast<const uint8_t*>(&v.bits));
+            break;
+        case Value::Array: {
+            os << "[";
+            size_t s = prim_size(v.prim);
+            for (size_t i = 0; i < v.array_size(); i++) {
+                if (i) os << ", ";
+                print_scalar(os, v.prim, v.data.data() + i * s);
+            }
+            os << "]";
+            break;
+        }
+        case Value::String:
+            os << "'" << v.str << "'";
+            break;
+        case Value::WString:
+            os << "<wstring, " << v.wstr.size() << " units>";
+            break;
+        case Value::List:
+            for (const auto& item : v.items) {
+                os << pad << "-";
+                if (item.kind == Value::Struct) {
+                    os << "\n";
+                    print(os, item, indent + 1);
+                } else {
+                    os << " ";
+                    print(os, item, 0);
+                    os << "\n";
+                }
+            }
+            break;
+    }
+}
+
+}  // namespace dynamic
+}  // namespace cdr
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <iostream>
+#include <string>
+
+#include "dynamic_cdr.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <bridge_address> <key_expr> <type> <msg_file>..."
+              << std::endl;
+    std::cout << "Example: " << prog
+              << " localhost:7447 cmd_vel geometry_msgs/Twist"
+                 " /opt/ros/jazzy/share/geometry_msgs/msg/Twist.msg"
+                 " /opt/ros/jazzy/share/geometry_msgs/msg/Vector3.msg"
+              << std::endl;
+}
+
+void callback(z_loaned_sample_t* sample, void* arg) {
+    auto* plan = static_cast<const cdr::dynamic::Plan*>(arg);
+
+    z_view_slice_t payload;
+    z_bytes_get_contiguous_view(z_sample_payload(sample), &payload);
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+    size_t len = z_slice_len(z_loan(payload));
+
+    // Reuse the decoded tree across samples to avoid reallocating it
+    thread_local cdr::dynamic::Value value;
+    if (cdr::dynamic::decode(*plan, data, len, value)) {
+        cdr::dynamic::print(std::cout, value);
+        std::cout << "---" << std::endl;
+    } else {
+        std::cerr << "Deserialization failed" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        std::cerr << "Error: Bridge address, key expression, type and .msg files must be specified"
+                  << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* bridge_addr = argv[1];
+    const char* key_expr = argv[2];
+    const char* type_name = argv[3];
+
+    cdr::dynamic::Registry registry;
+    std::string error;
+    for (int i = 4; i < argc; i++) {
+        if (!registry.load(argv[i], &error)) {
+            std::cerr << "Failed to load " << argv[i] << ": " << error << std::endl;
+            return 1;
+        }
+    }
+
+    cdr::dynamic::Plan plan;
+    if (!cdr::dynamic::compile(registry, type_name, plan, &error)) {
+        std::cerr << "Failed to compile " << type_name << ": " << error << std::endl;
+        return 1;
+    }
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    std::cout << "Zenoh dynamic echo started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Key expression: " << key_expr << std::endl;
+    std::cout << "  Type: " << type_name << " (" << plan.ops.size() << " ops)" << std::endl;
+    std::cout << std::endl;
+
+    z_owned_closure_sample_t closure;
+    z_closure_sample(&closure, callback, NULL, &plan);
+
+    z_view_keyexpr_t keyexpr;
+    if (z_view_keyexpr_from_str(&keyexpr, key_expr) < 0) {
+        std::cerr << "Invalid key expression: " << key_expr << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    z_owned_subscriber_t subscriber;
+    if (z_declare_subscriber(z_loan(session), &subscriber, z_loan(keyexpr), z_move(closure), NULL) <
+        0) {
+        std::cerr << "Failed to create subscriber" << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    std::cout << "Waiting for messages... (Ctrl+C to exit)" << std::endl;
+
+    while (true) {
+        z_sleep_s(1);
+    }
+
+    z_drop(z_move(subscriber));
+    z_drop(z_move(session));
+    return 0;
+}
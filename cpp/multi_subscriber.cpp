@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <iostream>
+#include <string>
+
+#include "dispatch.hpp"
+#include "msg.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <bridge_address> [namespace]" << std::endl;
+    std::cout << "Example: " << prog << " localhost:7447 robot1" << std::endl;
+}
+
+void callback(z_loaned_sample_t* sample, void* arg) {
+    auto* table = static_cast<const dispatch::Table*>(arg);
+
+    z_view_string_t keystr;
+    z_keyexpr_as_view_string(z_sample_keyexpr(sample), &keystr);
+
+    z_view_slice_t payload;
+    z_bytes_get_contiguous_view(z_sample_payload(sample), &payload);
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+    size_t len = z_slice_len(z_loan(payload));
+
+    table->dispatch(z_string_data(z_loan(keystr)), z_string_len(z_loan(keystr)), data, len);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Error: Bridge address must be specified" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* bridge_addr = argv[1];
+    std::string prefix = (argc > 2) ? std::string(argv[2]) + "/" : "";
+
+    // Routes are fixed before the subscriber is declared, so the callback only reads the table
+    dispatch::Table table;
+    table.add<msg::Twist>(prefix + "cmd_vel", [](const msg::Twist& twist) {
+        std::cout << "cmd_vel: linear.x=" << twist.linear.x << ", angular.z=" << twist.angular.z
+                  << std::endl;
+    });
+    table.add<msg::Twist>(prefix + "turtle1/cmd_vel", [](const msg::Twist& twist) {
+        std::cout << "turtle1/cmd_vel: linear.x=" << twist.linear.x
+                  << ", angular.z=" << twist.angular.z << std::endl;
+    });
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    std::string key = prefix + "**";
+
+    std::cout << "Zenoh multi-topic subscriber started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Key expression: " << key << " (" << table.size() << " routes)" << std::endl;
+    std::cout << std::endl;
+
+    z_owned_closure_sample_t closure;
+    z_closure_sample(&closure, callback, NULL, &table);
+
+    z_view_keyexpr_t keyexpr;
+    if (z_view_keyexpr_from_str(&keyexpr, key.c_str()) < 0) {
+        std::cerr << "Invalid key expression: " << key << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    z_owned_subscriber_t subscriber;
+    if (z_declare_subscriber(z_loan(session), &subscriber, z_loan(keyexpr), z_move(closure), NULL) <
+        0) {
+        std::cerr << "Failed to create subscriber" << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    std::cout << "Waiting for messages... (Ctrl+C to exit)" << std::endl;
+
+    while (true) {
+        z_sleep_s(1);
+    }
+
+    z_drop(z_move(subscriber));
+    z_drop(z_move(session));
+    return 0;
+}
@@ -4,8 +4,10 @@
 #include <zenoh.h>
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 #include "msg.hpp"
@@ -15,6 +17,28 @@ void print_usage(const char* prog) {
     std::cout << "Example: " << prog << " localhost:7447 0.5 0.2" << std::endl;
 }
 
+// Tracks whether any subscriber (e.g. the bridge route for a ROS2 subscriber) matches
+struct MatchingState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool matching = false;
+};
+
+void matching_handler(const z_matching_status_t* status, void* ctx) {
+    auto* state = static_cast<MatchingState*>(ctx);
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->matching = status->matching;
+    }
+    state->cv.notify_all();
+
+    if (status->matching) {
+        std::cout << "Subscriber matched, publishing" << std::endl;
+    } else {
+        std::cout << "No matching subscribers, pausing" << std::endl;
+    }
+}
+
 int main(int argc, char** argv) {
     if (argc < 2) {
         std::cerr << "Error: Bridge address must be specified" << std::endl;
@@ -53,6 +77,28 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // Skip serialization and sending entirely while nobody is listening
+    MatchingState state;
+
+    // Seed with the current status before the listener exists, so any status change it
+    // reports afterwards always overrides the seed
+    z_matching_status_t initial_status;
+    if (z_publisher_get_matching_status(z_loan(publisher), &initial_status) == Z_OK) {
+        state.matching = initial_status.matching;
+    }
+
+    z_owned_closure_matching_status_t matching_closure;
+    z_closure_matching_status(&matching_closure, matching_handler, NULL, &state);
+
+    z_owned_matching_listener_t matching_listener;
+    if (z_publisher_declare_matching_listener(z_loan(publisher), &matching_listener,
+                                              z_move(matching_closure)) < 0) {
+        std::cerr << "Failed to create matching listener" << std::endl;
+        z_drop(z_move(publisher));
+        z_drop(z_move(session));
+        return 1;
+    }
+
     std::cout << "Zenoh cmd_vel publisher started" << std::endl;
     std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
     std::cout << "  Topic: cmd_vel -> ROS2 /cmd_vel" << std::endl;
@@ -60,6 +106,14 @@ int main(int argc, char** argv) {
     std::cout << std::endl;
 
     while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            if (!state.matching) {
+                std::cout << "Waiting for subscribers..." << std::endl;
+                state.cv.wait(lock, [&state] { return state.matching; });
+            }
+        }
+
         msg::Twist twist{{linear_x, 0, 0}, {0, 0, angular_z}};
         auto payload = msg::serialize(twist);
 
@@ -72,6 +126,7 @@ int main(int argc, char** argv) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
+    z_drop(z_move(matching_listener));
     z_drop(z_move(publisher));
     z_drop(z_move(session));
     return 0;
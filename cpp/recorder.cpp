@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "recording.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <bridge_address> <key_expr> <output_file>" << std::endl;
+    std::cout << "Example: " << prog << " localhost:7447 \"**\" capture.rec" << std::endl;
+}
+
+struct RecorderState {
+    std::mutex mutex;
+    recording::Writer writer;
+};
+
+void callback(z_loaned_sample_t* sample, void* arg) {
+    auto* state = static_cast<RecorderState*>(arg);
+    uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+
+    z_view_string_t keystr;
+    z_keyexpr_as_view_string(z_sample_keyexpr(sample), &keystr);
+    std::string key(z_string_data(z_loan(keystr)), z_string_len(z_loan(keystr)));
+
+    // Large payloads may arrive fragmented; those are copied into one buffer
+    const z_loaned_bytes_t* bytes = z_sample_payload(sample);
+    std::vector<uint8_t> copy;
+    const uint8_t* data;
+    size_t len;
+    z_view_slice_t payload;
+    if (z_bytes_get_contiguous_view(bytes, &payload) == Z_OK) {
+        data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+        len = z_slice_len(z_loan(payload));
+    } else {
+        copy.resize(z_bytes_len(bytes));
+        z_bytes_reader_t reader = z_bytes_get_reader(bytes);
+        if (z_bytes_reader_read(&reader, copy.data(), copy.size()) != copy.size()) {
+            std::cerr << "Failed to read sample payload on " << key << std::endl;
+            return;
+        }
+        data = copy.data();
+        len = copy.size();
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->writer.append(key, now_ns, data, len)) {
+        std::cerr << "Failed to record sample on " << key << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Error: Bridge address, key expression and output file must be specified"
+                  << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* bridge_addr = argv[1];
+    const char* key_expr = argv[2];
+    const char* output_file = argv[3];
+
+    RecorderState state;
+    if (!state.writer.open(output_file)) {
+        std::cerr << "Failed to open output file: " << output_file << std::endl;
+        return 1;
+    }
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    std::cout << "Zenoh recorder started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Key expression: " << key_expr << std::endl;
+    std::cout << "  Output: " << output_file << std::endl;
+    std::cout << std::endl;
+
+    z_owned_closure_sample_t closure;
+    z_closure_sample(&closure, callback, NULL, &state);
+
+    z_view_keyexpr_t keyexpr;
+    if (z_view_keyexpr_from_str(&keyexpr, key_expr) < 0) {
+        std::cerr << "Invalid key expression: " << key_expr << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    z_owned_subscriber_t subscriber;
+    if (z_declare_subscriber(z_loan(session), &subscriber, z_loan(keyexpr), z_move(closure), NULL) <
+        0) {
+        std::cerr << "Failed to create subscriber" << std::endl;
+        z_drop(z_move(session));
+        return 1;
+    }
+
+    std::cout << "Recording... (Ctrl+C to exit)" << std::endl;
+
+    while (true) {
+        z_sleep_s(1);
+        uint64_t count;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            count = state.writer.sample_count();
+        }
+        std::cout << "Recorded " << count << " samples" << std::endl;
+    }
+
+    z_drop(z_move(subscriber));
+    z_drop(z_move(session));
+    return 0;
+}
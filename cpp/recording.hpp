@@ -0,0 +1,361 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+/**
+ * Append-only, memory-mapped recording of raw CDR samples
+ *
+ * File layout (little endian, all records 8-byte aligned):
+ *   FileHeader
+ *   Chunk 0: ChunkHeader, Record, Record, ...
+ *   Chunk 1: ChunkHeader, Record, Record, ...
+ *
+ * Each record is a RecordHeader followed by its payload:
+ *   - kKey:    payload is the key expression string for key_id (written once per key)
+ *   - kSample: payload is the raw CDR bytes received on key_id
+ *
+ * Chunk headers carry the record count and time range, so they double as the
+ * index: a time range can be located from the chunk headers alone. Chunk
+ * headers are updated after every record, so a file cut short by a crash is
+ * still readable up to the last record.
+ *
+ * Writer is not thread-safe; serialize calls to append() when recording from
+ * Zenoh callbacks.
+ *
+ * Usage:
+ *   recording::Writer w;
+ *   w.open("cmd_vel.rec");
+ *   w.append("cmd_vel", timestamp_ns, data, len);
+ *
+ *   recording::Reader r;
+ *   r.open("cmd_vel.rec");
+ *   r.for_each([](const recording::Sample& s) { ... });
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace recording {
+
+constexpr char kMagic[8] = {'Z', 'C', 'D', 'R', 'R', 'E', 'C', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kChunkMagic = 0x4b4e4843;  // "CHNK"
+constexpr size_t kDefaultChunkSize = 4 << 20;
+
+enum RecordKind : uint32_t { kKey = 1, kSample = 2 };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+};
+
+struct ChunkHeader {
+    uint32_t magic;
+    uint32_t record_count;
+    uint64_t size;      // Total chunk size including this header
+    uint64_t used;      // Bytes written including this header
+    uint64_t first_ns;  // Timestamp of the first sample (unset if the chunk has none)
+    uint64_t last_ns;   // Timestamp of the last sample
+};
+
+struct RecordHeader {
+    uint64_t timestamp_ns;
+    uint32_t key_id;
+    uint32_t kind;
+    uint32_t len;  // Payload length, excluding padding
+    uint32_t reserved;
+};
+
+struct Sample {
+    uint64_t timestamp_ns;
+    uint32_t key_id;
+    const uint8_t* data;
+    size_t len;
+};
+
+// Chunk index entry
+struct Chunk {
+    uint64_t offset;
+    uint32_t record_count;
+    uint64_t first_ns;
+    uint64_t last_ns;
+};
+
+inline size_t align8(size_t n) { return (n + 7) & ~size_t(7); }
+
+// mmap requires page-aligned offsets; map from the page boundary below offset
+struct Mapping {
+    uint8_t* base = nullptr;
+    size_t length = 0;
+    uint8_t* data = nullptr;
+
+    bool map(int fd, uint64_t offset, size_t len, int prot) {
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        uint64_t start = offset - offset % page;
+        length = len + (offset - start);
+        void* p = mmap(nullptr, length, prot, MAP_SHARED, fd, static_cast<off_t>(start));
+        if (p == MAP_FAILED) {
+            base = data = nullptr;
+            length = 0;
+            return false;
+        }
+        base = static_cast<uint8_t*>(p);
+        data = base + (offset - start);
+        return true;
+    }
+    void unmap() {
+        if (base) munmap(base, length);
+        base = data = nullptr;
+        length = 0;
+    }
+};
+
+// ==================== Writer ====================
+
+class Writer {
+   public:
+    explicit Writer(size_t chunk_size = kDefaultChunkSize) : chunk_size_(align8(chunk_size)) {}
+    ~Writer() { close(); }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) return false;
+
+        FileHeader header{};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.header_size = static_cast<uint32_t>(align8(sizeof(FileHeader)));
+        if (pwrite(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+            close();
+            return false;
+        }
+        next_chunk_ = header.header_size;
+        return true;
+    }
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // Append one raw CDR payload received on key
+    bool append(const std::string& key, uint64_t timestamp_ns, const uint8_t* data, size_t len) {
+        if (fd_ < 0) return false;
+        auto it = key_ids_.find(key);
+        uint32_t key_id;
+        if (it == key_ids_.end()) {
+            key_id = static_cast<uint32_t>(key_ids_.size());
+            if (!write_record(kKey, key_id, timestamp_ns,
+                              reinterpret_cast<const uint8_t*>(key.data()), key.size())) {
+                return false;
+            }
+            key_ids_.emplace(key, key_id);
+        } else {
+            key_id = it->second;
+        }
+        return write_record(kSample, key_id, timestamp_ns, data, len);
+    }
+
+    uint64_t sample_count() const { return sample_count_; }
+
+    void close() {
+        if (fd_ < 0) return;
+        uint64_t end = next_chunk_;
+        if (chunk_.data) {
+            // Shrink the last chunk to what was actually written
+            auto* header = reinterpret_cast<ChunkHeader*>(chunk_.data);
+            header->size = header->used;
+            end = chunk_offset_ + header->used;
+            msync(chunk_.base, chunk_.length, MS_SYNC);
+            chunk_.unmap();
+        }
+        if (ftruncate(fd_, static_cast<off_t>(end)) != 0) {
+            // Trailing unused bytes are harmless; the chunk header bounds the data
+        }
+        ::close(fd_);
+        fd_ = -1;
+        key_ids_.clear();
+    }
+
+   private:
+    bool write_record(uint32_t kind, uint32_t key_id, uint64_t timestamp_ns, const uint8_t* data,
+                      size_t len) {
+        size_t need = sizeof(RecordHeader) + align8(len);
+        if (!chunk_.data || chunk_used() + need > chunk_capacity_) {
+            if (!next_chunk(need)) return false;
+        }
+        auto* header = reinterpret_cast<ChunkHeader*>(chunk_.data);
+        uint8_t* p = chunk_.data + header->used;
+
+        RecordHeader record{timestamp_ns, key_id, kind, static_cast<uint32_t>(len), 0};
+        memcpy(p, &record, sizeof(record));
+        if (len > 0) memcpy(p + sizeof(record), data, len);
+
+        // Publish the record by updating the chunk header last
+        if (kind == kSample) {
+            if (!chunk_has_sample_) header->first_ns = timestamp_ns;
+            chunk_has_sample_ = true;
+            header->last_ns = timestamp_ns;
+            sample_count_++;
+        }
+        header->record_count++;
+        header->used += need;
+        return true;
+    }
+
+    size_t chunk_used() const { return reinterpret_cast<const ChunkHeader*>(chunk_.data)->used; }
+
+    bool next_chunk(size_t need) {
+        if (chunk_.data) {
+            chunk_.unmap();
+            next_chunk_ = chunk_offset_ + chunk_capacity_;
+        }
+        size_t capacity = chunk_size_;
+        if (sizeof(ChunkHeader) + need > capacity) capacity = align8(sizeof(ChunkHeader) + need);
+
+        if (ftruncate(fd_, static_cast<off_t>(next_chunk_ + capacity)) != 0) return false;
+        if (!chunk_.map(fd_, next_chunk_, capacity, PROT_READ | PROT_WRITE)) return false;
+
+        chunk_offset_ = next_chunk_;
+        chunk_capacity_ = capacity;
+        chunk_has_sample_ = false;
+        ChunkHeader header{kChunkMagic, 0, capacity, sizeof(ChunkHeader), 0, 0};
+        memcpy(chunk_.data, &header, sizeof(header));
+        return true;
+    }
+
+    size_t chunk_size_;
+    int fd_ = -1;
+    Mapping chunk_;
+    uint64_t chunk_offset_ = 0;
+    size_t chunk_capacity_ = 0;
+    bool chunk_has_sample_ = false;
+    uint64_t next_chunk_ = 0;
+    uint64_t sample_count_ = 0;
+    std::unordered_map<std::string, uint32_t> key_ids_;
+};
+
+// ==================== Reader ====================
+
+class Reader {
+   public:
+    Reader() = default;
+    ~Reader() { close(); }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Map the whole file and build the key table and chunk index
+    bool open(const std::string& path) {
+        close();
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return false;
+
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+            close();
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (!file_.map(fd_, 0, size_, PROT_READ)) {
+            close();
+            return false;
+        }
+
+        FileHeader header;
+        memcpy(&header, file_.data, sizeof(header));
+        if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+            close();
+            return false;
+        }
+
+        uint64_t offset = header.header_size;
+        while (offset + sizeof(ChunkHeader) <= size_) {
+            ChunkHeader chunk;
+            memcpy(&chunk, file_.data + offset, sizeof(chunk));
+            // Every chunk, even an unclosed last one, is sized to its full capacity on disk
+            if (chunk.magic != kChunkMagic || chunk.used < sizeof(ChunkHeader) ||
+                chunk.used > chunk.size || chunk.size > size_ - offset) {
+                break;
+            }
+            chunks_.push_back({offset, chunk.record_count, chunk.first_ns, chunk.last_ns});
+            scan_keys(offset, chunk);
+            offset += chunk.size;
+        }
+        return true;
+    }
+
+    void close() {
+        file_.unmap();
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+        size_ = 0;
+        chunks_.clear();
+        keys_.clear();
+    }
+
+    const std::vector<std::string>& keys() const { return keys_; }
+    const std::vector<Chunk>& chunks() const { return chunks_; }
+
+    // Visit every sample in recording order; payloads point into the mapping (no copy).
+    // Samples whose key_id has no key record are skipped.
+    template <typename F>
+    void for_each(F&& fn) const {
+        for (const auto& c : chunks_) {
+            ChunkHeader chunk;
+            memcpy(&chunk, file_.data + c.offset, sizeof(chunk));
+            uint64_t pos = c.offset + sizeof(ChunkHeader);
+            uint64_t end = c.offset + chunk.used;
+            RecordHeader record;
+            while (next_record(pos, end, record)) {
+                const uint8_t* payload = file_.data + pos + sizeof(record);
+                if (record.kind == kSample && record.key_id < keys_.size()) {
+                    fn(Sample{record.timestamp_ns, record.key_id, payload, record.len});
+                }
+                pos += sizeof(RecordHeader) + align8(record.len);
+            }
+        }
+    }
+
+   private:
+    // Read the record at pos; false at the end of the chunk or if the record does not fit
+    bool next_record(uint64_t pos, uint64_t end, RecordHeader& record) const {
+        if (pos + sizeof(RecordHeader) > end) return false;
+        memcpy(&record, file_.data + pos, sizeof(record));
+        return pos + sizeof(RecordHeader) + record.len <= end;
+    }
+
+    void scan_keys(uint64_t offset, const ChunkHeader& chunk) {
+        uint64_t pos = offset + sizeof(ChunkHeader);
+        uint64_t end = offset + chunk.used;
+        RecordHeader record;
+        while (next_record(pos, end, record)) {
+            if (record.kind == kKey) {
+                // The writer assigns key ids in order; anything else is corrupt
+                if (record.key_id > keys_.size()) return;
+                if (record.key_id == keys_.size()) keys_.emplace_back();
+                keys_[record.key_id].assign(
+                    reinterpret_cast<const char*>(file_.data + pos + sizeof(record)), record.len);
+            }
+            pos += sizeof(RecordHeader) + align8(record.len);
+        }
+    }
+
+    int fd_ = -1;
+    size_t size_ = 0;
+    Mapping file_;
+    std::vector<Chunk> chunks_;
+    std::vector<std::string> keys_;
+};
+
+}  // namespace recording
@@ -0,0 +1,118 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+#include <zenoh.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "recording.hpp"
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " <bridge_address> <input_file> [rate]" << std::endl;
+    std::cout << "  rate: 1.0 = original timing, 2.0 = twice as fast, 0 = as fast as possible"
+              << std::endl;
+    std::cout << "Example: " << prog << " localhost:7447 capture.rec 1.0" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Error: Bridge address and input file must be specified" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    const char* bridge_addr = argv[1];
+    const char* input_file = argv[2];
+    double rate = (argc > 3) ? std::atof(argv[3]) : 1.0;
+
+    recording::Reader reader;
+    if (!reader.open(input_file)) {
+        std::cerr << "Failed to open recording: " << input_file << std::endl;
+        return 1;
+    }
+
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"tcp/%s\"]", bridge_addr);
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_CONNECT_KEY, endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        return 1;
+    }
+
+    z_owned_session_t session;
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << bridge_addr << std::endl;
+        return 1;
+    }
+
+    // One publisher per recorded key, indexed by key id
+    std::vector<z_owned_publisher_t> publishers(reader.keys().size());
+    for (size_t i = 0; i < reader.keys().size(); i++) {
+        z_view_keyexpr_t keyexpr;
+        if (z_view_keyexpr_from_str(&keyexpr, reader.keys()[i].c_str()) < 0 ||
+            z_declare_publisher(z_loan(session), &publishers[i], z_loan(keyexpr), NULL) < 0) {
+            std::cerr << "Failed to create publisher: " << reader.keys()[i] << std::endl;
+            for (size_t j = 0; j < i; j++) z_drop(z_move(publishers[j]));
+            z_drop(z_move(session));
+            return 1;
+        }
+    }
+
+    std::cout << "Zenoh replayer started" << std::endl;
+    std::cout << "  Connection: tcp/" << bridge_addr << std::endl;
+    std::cout << "  Input: " << input_file << " (" << reader.keys().size() << " keys, "
+              << reader.chunks().size() << " chunks)" << std::endl;
+    std::cout << "  Rate: " << (rate > 0 ? std::to_string(rate) + "x" : "max") << std::endl;
+    std::cout << std::endl;
+
+    // Samples are scheduled against the first sample (not the previous one), so timing
+    // error does not accumulate over long recordings
+    bool started = false;
+    uint64_t first_ns = 0;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+
+    reader.for_each([&](const recording::Sample& sample) {
+        if (!started) {
+            first_ns = sample.timestamp_ns;
+            start = std::chrono::steady_clock::now();
+            started = true;
+        }
+        if (rate > 0 && sample.timestamp_ns > first_ns) {
+            auto offset = std::chrono::nanoseconds(
+                static_cast<int64_t>((sample.timestamp_ns - first_ns) / rate));
+            std::this_thread::sleep_until(start + offset);
+        }
+
+        if (sample.key_id >= publishers.size()) return;
+
+        // Payload points into the read-only mapping, which outlives the put
+        z_owned_bytes_t data;
+        z_bytes_from_buf(&data, const_cast<uint8_t*>(sample.data), sample.len, NULL, NULL);
+        z_publisher_put(z_loan(publishers[sample.key_id]), z_move(data), NULL);
+
+        count++;
+        bytes += sample.len;
+    });
+
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Replayed " << count << " samples (" << bytes << " bytes) in " << elapsed << " s"
+              << std::endl;
+    if (elapsed > 0) {
+        std::cout << "  Throughput: " << count / elapsed << " msg/s, " << bytes / elapsed / 1e6
+                  << " MB/s" << std::endl;
+    }
+
+    for (auto& publisher : publishers) z_drop(z_move(publisher));
+    z_drop(z_move(session));
+    return 0;
+}
@@ -0,0 +1,689 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * N publishers x M subscribers (+ K service clients) scaling stress test
+ *
+ * Every node uses the same pattern as the example binaries: its own session,
+ * work done inline in Zenoh callbacks. Nodes run as threads of this process or
+ * as forked processes, all peers of one local hub session (the service server).
+ *
+ * For every combination of the swept parameters one CSV row is written:
+ * throughput, publish->receive latency percentiles, CPU time per delivered
+ * message, drops, and service round-trip latency.
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <zenoh.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cdr.hpp"
+#include "srv.hpp"
+
+// Message carrying its own sequence number and send time
+struct StressMsg {
+    uint32_t pub_id;
+    uint64_t seq;
+    uint64_t stamp_ns;
+    std::vector<uint8_t> data;
+};
+
+constexpr size_t kMsgOverhead = 32;  // CDR size of StressMsg with empty data
+constexpr const char* kTopic = "stress/topic";
+constexpr const char* kService = "stress/add_two_ints";
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t cpu_ns() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    auto to_ns = [](const timeval& tv) {
+        return uint64_t(tv.tv_sec) * 1000000000 + uint64_t(tv.tv_usec) * 1000;
+    };
+    return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+// ==================== Latency Histogram ====================
+
+// Log-linear buckets (16 per power of two), fixed size so results can cross a pipe
+struct Histogram {
+    static constexpr int kSub = 16;
+    static constexpr int kBuckets = 64 * kSub;
+    uint64_t counts[kBuckets];
+    uint64_t total;
+    uint64_t max;
+
+    void clear() { memset(this, 0, sizeof(*this)); }
+
+    static int index(uint64_t v) {
+        if (v < kSub) return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        return (msb - 3) * kSub + static_cast<int>((v >> (msb - 4)) & (kSub - 1));
+    }
+    static uint64_t lower_bound(int i) {
+        if (i < kSub) return i;
+        int msb = i / kSub + 3;
+        return uint64_t(kSub + i % kSub) << (msb - 4);
+    }
+
+    void add(uint64_t v) {
+        counts[index(v)]++;
+        total++;
+        if (v > max) max = v;
+    }
+    void merge(const Histogram& o) {
+        for (int i = 0; i < kBuckets; i++) counts[i] += o.counts[i];
+        total += o.total;
+        if (o.max > max) max = o.max;
+    }
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p * (total - 1));
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; i++) {
+            seen += counts[i];
+            if (seen > rank) return lower_bound(i);
+        }
+        return max;
+    }
+};
+
+// Plain data so process mode can send it back through a pipe
+struct Result {
+    uint64_t sent;
+    uint64_t received;
+    uint64_t query_ok;
+    uint64_t query_err;
+    uint64_t cpu_ns;
+    Histogram latency;
+    Histogram query_latency;
+
+    void clear() { memset(this, 0, sizeof(*this)); }
+    void merge(const Result& o) {
+        sent += o.sent;
+        received += o.received;
+        query_ok += o.query_ok;
+        query_err += o.query_err;
+        cpu_ns += o.cpu_ns;
+        latency.merge(o.latency);
+        query_latency.merge(o.query_latency);
+    }
+};
+
+// ==================== Run Configuration ====================
+
+enum class Role { Server, Subscriber, Publisher, Client };
+
+struct RunConfig {
+    std::string endpoint;
+    size_t payload;
+    double rate;  // Per publisher / client, 0 = as fast as possible
+    double duration;
+    bool print;
+};
+
+// Phase synchronization between the driver and the nodes
+class Sync {
+   public:
+    virtual ~Sync() = default;
+    virtual void ready() = 0;       // Node is set up
+    virtual void wait_start() = 0;  // Block until the measured phase begins
+    virtual void wait_stop() = 0;   // Block until the measured phase ends
+};
+
+// ==================== Nodes ====================
+
+bool open_session(const RunConfig& cfg, bool listen, z_owned_session_t& session) {
+    z_owned_config_t config;
+    z_config_default(&config);
+
+    char endpoint[256];
+    snprintf(endpoint, sizeof(endpoint), "[\"%s\"]", cfg.endpoint.c_str());
+
+    if (zc_config_insert_json5(z_loan_mut(config), Z_CONFIG_MODE_KEY, "\"peer\"") < 0 ||
+        zc_config_insert_json5(z_loan_mut(config), "scouting/multicast/enabled", "false") < 0 ||
+        zc_config_insert_json5(z_loan_mut(config),
+                               listen ? Z_CONFIG_LISTEN_KEY : Z_CONFIG_CONNECT_KEY,
+                               endpoint) < 0) {
+        std::cerr << "Configuration error" << std::endl;
+        z_drop(z_move(config));
+        return false;
+    }
+    if (z_open(&session, z_move(config), NULL) < 0) {
+        std::cerr << "Connection failed: " << cfg.endpoint << std::endl;
+        return false;
+    }
+    return true;
+}
+
+struct SubscriberState {
+    std::mutex mutex;
+    Result* result;
+    bool print;
+};
+
+void sample_handler(z_loaned_sample_t* sample, void* arg) {
+    uint64_t recv_ns = now_ns();
+    auto* state = static_cast<SubscriberState*>(arg);
+
+    z_view_slice_t payload;
+    z_bytes_get_contiguous_view(z_sample_payload(sample), &payload);
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+    size_t len = z_slice_len(z_loan(payload));
+
+    StressMsg msg;
+    if (!cdr::deserialize(data, len, msg)) return;
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->result->received++;
+    state->result->latency.add(recv_ns - msg.stamp_ns);
+    if (state->print) {
+        std::cout << "Received: pub=" << msg.pub_id << ", seq=" << msg.seq << std::endl;
+    }
+}
+
+void query_handler(z_loaned_query_t* query, void* ctx) {
+    z_view_slice_t payload;
+    const z_loaned_bytes_t* bytes = z_query_payload(query);
+    if (bytes == nullptr || z_bytes_get_contiguous_view(bytes, &payload) != Z_OK) return;
+
+    srv::AddTwoIntsRequest request;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(z_slice_data(z_loan(payload)));
+    if (!srv::deserialize(data, z_slice_len(z_loan(payload)), request)) return;
+
+    srv::AddTwoIntsResponse response{request.a + request.b};
+    auto response_data = srv::serialize(response);
+
+    z_query_reply_options_t options;
+    z_query_reply_options_default(&options);
+
+    z_owned_bytes_t reply_payload;
+    z_bytes_from_buf(&reply_payload, response_data.data(), response_data.size(), NULL, NULL);
+    z_query_reply(query, z_query_keyexpr(query), z_move(reply_payload), &options);
+}
+
+// Sleep until the next send slot when a rate is set
+class Pacer {
+   public:
+    explicit Pacer(double rate) : rate_(rate), next_(std::chrono::steady_clock::now()) {}
+    void wait() {
+        if (rate_ <= 0) return;
+        next_ += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate_));
+        std::this_thread::sleep_until(next_);
+    }
+
+   private:
+    double rate_;
+    std::chrono::steady_clock::time_point next_;
+};
+
+Result run_node(Role role, uint32_t id, const RunConfig& cfg, Sync& sync) {
+    Result result;
+    result.clear();
+
+    // CPU is sampled over the same window in both modes: from the start signal to the
+    // stop signal, so setup, warmup and teardown are excluded
+    uint64_t cpu_start = 0;
+    auto begin = [&] {
+        sync.wait_start();
+        cpu_start = cpu_ns();
+    };
+    auto end = [&] {
+        sync.wait_stop();
+        result.cpu_ns = cpu_ns() - cpu_start;
+    };
+
+    z_owned_session_t session;
+    if (!open_session(cfg, role == Role::Server, session)) {
+        sync.ready();
+        begin();
+        end();
+        return result;
+    }
+
+    z_view_keyexpr_t topic;
+    z_view_keyexpr_from_str(&topic, kTopic);
+    z_view_keyexpr_t service;
+    z_view_keyexpr_from_str(&service, kService);
+
+    switch (role) {
+        case Role::Server: {
+            z_owned_closure_query_t closure;
+            z_closure_query(&closure, query_handler, NULL, NULL);
+            z_owned_queryable_t queryable;
+            bool ok = z_declare_queryable(z_loan(session), &queryable, z_loan(service),
+                                          z_move(closure), NULL) == Z_OK;
+            if (!ok) std::cerr << "Failed to create service" << std::endl;
+            sync.ready();
+            begin();
+            end();
+            if (ok) z_drop(z_move(queryable));
+            break;
+        }
+        case Role::Subscriber: {
+            SubscriberState state;
+            state.result = &result;
+            state.print = cfg.print;
+            z_owned_closure_sample_t closure;
+            z_closure_sample(&closure, sample_handler, NULL, &state);
+            z_owned_subscriber_t subscriber;
+            bool ok = z_declare_subscriber(z_loan(session), &subscriber, z_loan(topic),
+                                           z_move(closure), NULL) == Z_OK;
+            if (!ok) std::cerr << "Failed to create subscriber" << std::endl;
+            sync.ready();
+            begin();
+            end();
+            if (ok) z_drop(z_move(subscriber));
+            break;
+        }
+        case Role::Publisher: {
+            z_owned_publisher_t publisher;
+            bool ok =
+                z_declare_publisher(z_loan(session), &publisher, z_loan(topic), NULL) == Z_OK;
+            if (!ok) std::cerr << "Failed to create publisher" << std::endl;
+            sync.ready();
+            begin();
+            if (!ok) {
+                end();
+                break;
+            }
+
+            StressMsg msg{id, 0, 0, {}};
+            msg.data.resize(cfg.payload > kMsgOverhead ? cfg.payload - kMsgOverhead : 0);
+            uint64_t deadline = now_ns() + static_cast<uint64_t>(cfg.duration * 1e9);
+            Pacer pacer(cfg.rate);
+            while (now_ns() < deadline) {
+                msg.stamp_ns = now_ns();
+                auto payload = cdr::serialize(msg);
+
+                z_owned_bytes_t data;
+                z_bytes_from_buf(&data, payload.data(), payload.size(), NULL, NULL);
+                z_publisher_put(z_loan(publisher), z_move(data), NULL);
+
+                msg.seq++;
+                pacer.wait();
+            }
+            result.sent = msg.seq;
+            end();
+            z_drop(z_move(publisher));
+            break;
+        }
+        case Role::Client: {
+            sync.ready();
+            begin();
+
+            uint64_t deadline = now_ns() + static_cast<uint64_t>(cfg.duration * 1e9);
+            Pacer pacer(cfg.rate);
+            int64_t n = 0;
+            while (now_ns() < deadline) {
+                auto request_data = srv::serialize(srv::AddTwoIntsRequest{n, int64_t(id)});
+                z_owned_bytes_t payload;
+                z_bytes_from_buf(&payload, request_data.data(), request_data.size(), NULL, NULL);
+
+                z_get_options_t opts;
+                z_get_options_default(&opts);
+                opts.timeout_ms = 1000;
+                opts.payload = z_move(payload);
+
+                z_owned_fifo_handler_reply_t handler;
+                z_owned_closure_reply_t closure;
+                z_fifo_channel_reply_new(&closure, &handler, 16);
+
+                uint64_t start = now_ns();
+                z_get(z_loan(session), z_loan(service), "", z_move(closure), &opts);
+
+                bool ok = false;
+                z_owned_reply_t reply;
+                while (z_recv(z_loan(handler), &reply) == Z_OK) {
+                    ok = ok || z_reply_is_ok(z_loan(reply));
+                    z_drop(z_move(reply));
+                }
+                z_drop(z_move(handler));
+
+                if (ok) {
+                    result.query_ok++;
+                    result.query_latency.add(now_ns() - start);
+                } else {
+                    result.query_err++;
+                }
+                n++;
+                pacer.wait();
+            }
+            end();
+            break;
+        }
+    }
+
+    z_drop(z_move(session));
+    return result;
+}
+
+// ==================== Thread Mode ====================
+
+class ThreadSync : public Sync {
+   public:
+    void ready() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_++;
+        cv_.notify_all();
+    }
+    void wait_start() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return started_; });
+    }
+    void wait_stop() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stopped_; });
+    }
+
+    void wait_ready(size_t n) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return ready_ >= n; });
+    }
+    void start() { set(started_); }
+    void stop() { set(stopped_); }
+
+   private:
+    void set(bool& flag) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flag = true;
+        cv_.notify_all();
+    }
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t ready_ = 0;
+    bool started_ = false;
+    bool stopped_ = false;
+};
+
+// ==================== Process Mode ====================
+
+bool write_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool read_all(int fd, void* data, size_t len) {
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n <= 0) return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+// Child side: one byte per phase from the parent, one byte back when ready
+class PipeSync : public Sync {
+   public:
+    PipeSync(int from_parent, int to_parent) : in_(from_parent), out_(to_parent) {}
+    void ready() override {
+        char c = 'R';
+        write_all(out_, &c, 1);
+    }
+    void wait_start() override {
+        char c;
+        read_all(in_, &c, 1);
+    }
+    void wait_stop() override {
+        char c;
+        read_all(in_, &c, 1);
+    }
+
+   private:
+    int in_;
+    int out_;
+};
+
+struct Child {
+    pid_t pid;
+    int to_child;
+    int from_child;
+};
+
+// ==================== Driver ====================
+
+struct Scenario {
+    size_t pubs;
+    size_t subs;
+    size_t clients;
+};
+
+std::vector<std::pair<Role, uint32_t>> nodes_for(const Scenario& s) {
+    // Server first (it listens), then receivers, then senders
+    std::vector<std::pair<Role, uint32_t>> nodes{{Role::Server, 0}};
+    for (size_t i = 0; i < s.subs; i++) nodes.push_back({Role::Subscriber, uint32_t(i)});
+    for (size_t i = 0; i < s.pubs; i++) nodes.push_back({Role::Publisher, uint32_t(i)});
+    for (size_t i = 0; i < s.clients; i++) nodes.push_back({Role::Client, uint32_t(i)});
+    return nodes;
+}
+
+constexpr auto kWarmup = std::chrono::milliseconds(500);
+constexpr auto kDrain = std::chrono::milliseconds(300);
+
+Result run_threads(const Scenario& s, const RunConfig& cfg) {
+    auto nodes = nodes_for(s);
+    std::vector<Result> results(nodes.size());
+    std::vector<std::thread> threads;
+    ThreadSync sync;
+
+    // Start the listening server before anyone connects to it
+    threads.emplace_back([&] { results[0] = run_node(nodes[0].first, 0, cfg, sync); });
+    sync.wait_ready(1);
+    for (size_t i = 1; i < nodes.size(); i++) {
+        threads.emplace_back(
+            [&, i] { results[i] = run_node(nodes[i].first, nodes[i].second, cfg, sync); });
+    }
+    sync.wait_ready(nodes.size());
+    std::this_thread::sleep_for(kWarmup);
+
+    sync.start();
+    std::this_thread::sleep_for(std::chrono::duration<double>(cfg.duration) + kDrain);
+    sync.stop();
+    for (auto& t : threads) t.join();
+
+    Result total;
+    total.clear();
+    for (const auto& r : results) total.merge(r);
+    // All nodes share this process, so each measured the same process-wide window
+    total.cpu_ns = results[0].cpu_ns;
+    return total;
+}
+
+Result run_processes(const Scenario& s, const RunConfig& cfg) {
+    auto nodes = nodes_for(s);
+    std::vector<Child> children;
+    Result total;
+    total.clear();
+
+    auto spawn = [&](size_t i) {
+        int down[2], up[2];
+        if (pipe(down) != 0 || pipe(up) != 0) return false;
+        pid_t pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            close(down[1]);
+            close(up[0]);
+            PipeSync sync(down[0], up[1]);
+            Result result = run_node(nodes[i].first, nodes[i].second, cfg, sync);
+            write_all(up[1], &result, sizeof(result));
+            _exit(0);
+        }
+        close(down[0]);
+        close(up[1]);
+        children.push_back({pid, down[1], up[0]});
+        return true;
+    };
+    auto wait_ready = [](const Child& c) {
+        char r;
+        return read_all(c.from_child, &r, 1);
+    };
+    auto signal_all = [&](char c) {
+        for (const auto& child : children) write_all(child.to_child, &c, 1);
+    };
+
+    bool ok = spawn(0) && wait_ready(children[0]);
+    for (size_t i = 1; ok && i < nodes.size(); i++) ok = spawn(i);
+    for (size_t i = 1; ok && i < children.size(); i++) ok = wait_ready(children[i]);
+    if (!ok) std::cerr << "Failed to start node processes" << std::endl;
+
+    std::this_thread::sleep_for(kWarmup);
+    signal_all('S');
+    std::this_thread::sleep_for(std::chrono::duration<double>(cfg.duration) + kDrain);
+    signal_all('X');
+
+    for (const auto& child : children) {
+        Result r;
+        if (read_all(child.from_child, &r, sizeof(r))) total.merge(r);
+        close(child.to_child);
+        close(child.from_child);
+        waitpid(child.pid, NULL, 0);
+    }
+    return total;
+}
+
+// ==================== Main ====================
+
+std::vector<size_t> parse_list(const char* arg) {
+    std::vector<size_t> values;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::strtoul(item.c_str(), NULL, 10));
+    }
+    return values;
+}
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " [options]" << std::endl;
+    std::cout << "  --pubs <list>      Publisher counts (default: 1,2,4)" << std::endl;
+    std::cout << "  --subs <list>      Subscriber counts (default: 1,2,4)" << std::endl;
+    std::cout << "  --clients <list>   Service client counts (default: 0)" << std::endl;
+    std::cout << "  --sizes <list>     Payload sizes in bytes (default: 64,1024,65536)"
+              << std::endl;
+    std::cout << "  --rate <hz>        Per publisher/client rate, 0 = max (default: 0)"
+              << std::endl;
+    std::cout << "  --duration <s>     Measured seconds per scenario (default: 2)" << std::endl;
+    std::cout << "  --mode <m>         threads | processes (default: threads)" << std::endl;
+    std::cout << "  --endpoint <e>     Local hub endpoint (default: tcp/127.0.0.1:7450)"
+              << std::endl;
+    std::cout << "  --output <file>    CSV output (default: stdout)" << std::endl;
+    std::cout << "  --print            Print every received message, like subscriber.cpp"
+              << std::endl;
+    std::cout << "Example: " << prog << " --pubs 1,4 --subs 1,8 --sizes 64,4096 --mode processes"
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> pubs{1, 2, 4}, subs{1, 2, 4}, clients{0}, sizes{64, 1024, 65536};
+    RunConfig cfg{"tcp/127.0.0.1:7450", 0, 0, 2.0, false};
+    std::string mode = "threads";
+    std::string output;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--print") {
+            cfg.print = true;
+        } else if (arg == "--pubs" && has_value) {
+            pubs = parse_list(argv[++i]);
+        } else if (arg == "--subs" && has_value) {
+            subs = parse_list(argv[++i]);
+        } else if (arg == "--clients" && has_value) {
+            clients = parse_list(argv[++i]);
+        } else if (arg == "--sizes" && has_value) {
+            sizes = parse_list(argv[++i]);
+        } else if (arg == "--rate" && has_value) {
+            cfg.rate = std::atof(argv[++i]);
+        } else if (arg == "--duration" && has_value) {
+            cfg.duration = std::atof(argv[++i]);
+        } else if (arg == "--mode" && has_value) {
+            mode = argv[++i];
+        } else if (arg == "--endpoint" && has_value) {
+            cfg.endpoint = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            output = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (mode != "threads" && mode != "processes") {
+        std::cerr << "Error: Unknown mode " << mode << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Failed to open output file: " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+
+    out << "mode,pubs,subs,clients,payload_bytes,duration_s,sent,received,drops,msg_per_s,"
+           "mb_per_s,lat_p50_us,lat_p99_us,lat_p999_us,lat_max_us,cpu_us_per_msg,queries,"
+           "query_errors,query_p50_us,query_p99_us"
+        << std::endl;
+
+    for (size_t payload : sizes) {
+        for (size_t p : pubs) {
+            for (size_t s : subs) {
+                for (size_t c : clients) {
+                    cfg.payload = payload;
+                    Scenario scenario{p, s, c};
+                    Result r = (mode == "threads") ? run_threads(scenario, cfg)
+                                                   : run_processes(scenario, cfg);
+
+                    // Every subscriber should see every message
+                    uint64_t expected = r.sent * s;
+                    uint64_t drops = expected > r.received ? expected - r.received : 0;
+                    double msg_per_s = r.received / cfg.duration;
+                    uint64_t delivered = r.received + r.query_ok;
+
+                    out << mode << "," << p << "," << s << "," << c << "," << payload << ","
+                        << cfg.duration << "," << r.sent << "," << r.received << "," << drops
+                        << "," << msg_per_s << "," << msg_per_s * payload / 1e6 << ","
+                        << r.latency.percentile(0.5) / 1e3 << ","
+                        << r.latency.percentile(0.99) / 1e3 << ","
+                        << r.latency.percentile(0.999) / 1e3 << "," << r.latency.max / 1e3 << ","
+                        << (delivered ? r.cpu_ns / 1e3 / delivered : 0) << "," << r.query_ok
+                        << "," << r.query_err << "," << r.query_latency.percentile(0.5) / 1e3
+                        << "," << r.query_latency.percentile(0.99) / 1e3 << std::endl;
+                }
+            }
+        }
+    }
+    return 0;
+}
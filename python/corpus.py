@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ziqi Fan
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+CDR golden corpus conformance and throughput check (pycdr2 codec)
+
+Same cases and values as cpp/cdr_corpus.cpp. Prints one CSV row per case:
+  lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s
+"""
+
+import argparse
+import os
+import sys
+import time
+from dataclasses import dataclass
+
+from pycdr2 import IdlStruct
+from pycdr2.types import array, float32, float64, int8, int16, int32, int64, sequence, uint8, uint16, uint32, uint64
+
+from msg import Twist, Vector3
+
+# ==================== Corpus Types ====================
+
+
+@dataclass
+class Alignment(IdlStruct):
+    a: uint8
+    b: float64
+    c: uint8
+    d: uint16
+    e: uint8
+    f: uint32
+    g: bool
+    h: int64
+    i: int8
+    j: float32
+    k: uint8
+
+
+@dataclass
+class Limits(IdlStruct):
+    i8_min: int8
+    u8_max: uint8
+    i16_min: int16
+    u16_max: uint16
+    i32_min: int32
+    u32_max: uint32
+    i64_min: int64
+    u64_max: uint64
+    f32_max: float32
+    f32_inf: float32
+    f64_neg_zero: float64
+    f64_denorm: float64
+
+
+@dataclass
+class Strings(IdlStruct):
+    empty: str
+    a: uint8
+    odd: str
+    b: float64
+    utf8: str
+    c: uint16
+    names: sequence[str]
+
+
+@dataclass
+class Point(IdlStruct):
+    x: float64
+    y: float64
+    z: float64
+
+
+@dataclass
+class NestedSequences(IdlStruct):
+    grid: sequence[sequence[int16]]
+    tag: uint8
+    points: sequence[Point]
+    words: sequence[sequence[str]]
+    empty: sequence[float64]
+    tail: uint8
+    bytes: sequence[uint8]
+
+
+@dataclass
+class LargeArrays(IdlStruct):
+    head: uint8
+    samples: array[float32, 1024]
+    series: sequence[float64]
+    blob: sequence[uint8]
+
+
+# ==================== Corpus Values ====================
+
+CASES = [
+    (
+        "alignment",
+        lambda: Alignment(0x11, -1.5, 0x22, 0x3344, 0x55, 0x66778899, True, -0x0102030405060708, -7, 3.25, 0x77),
+    ),
+    (
+        "limits",
+        lambda: Limits(
+            -(2**7),
+            2**8 - 1,
+            -(2**15),
+            2**16 - 1,
+            -(2**31),
+            2**32 - 1,
+            -(2**63),
+            2**64 - 1,
+            3.4028234663852886e38,
+            float("inf"),
+            -0.0,
+            5e-324,
+        ),
+    ),
+    ("strings", lambda: Strings("", 0x01, "abc", 2.5, "héllo wörld ✓", 0xBEEF, ["", "x", "yz"])),
+    # pycdr2 has no wstring type
+    ("wstring", None),
+    (
+        "nested_sequences",
+        lambda: NestedSequences(
+            [[], [1], [2, -3, 4]],
+            0x7F,
+            [Point(1.0, 2.0, 3.0), Point(-0.5, 0.25, 8.0), Point(0.0, 0.0, -1.0)],
+            [["a", "bc"], [], ["def"]],
+            [],
+            0x80,
+            bytes([1, 2, 3, 4, 5]),
+        ),
+    ),
+    (
+        "large_arrays",
+        lambda: LargeArrays(
+            0x42,
+            [i * 0.25 for i in range(1024)],
+            [i * 0.5 - 1000.0 for i in range(4096)],
+            bytes((i * 7) & 0xFF for i in range(16384)),
+        ),
+    ),
+    ("twist", lambda: Twist(linear=Vector3(1.5, -2.25, 0.0), angular=Vector3(0.0, 0.0, 0.75))),
+]
+
+# ==================== Benchmark ====================
+
+
+def ns_per_op(min_seconds, op):
+    """Run op in doubling batches until min_seconds have elapsed; returns ns per op"""
+    start = time.perf_counter()
+    count = 0
+    batch = 1
+    while time.perf_counter() - start < min_seconds:
+        for _ in range(batch):
+            op()
+        count += batch
+        batch *= 2
+    return (time.perf_counter() - start) * 1e9 / count if count else 0.0
+
+
+def run_case(name, make, corpus, min_seconds):
+    """Check one case against corpus/<name>.cdr and print its CSV row; returns False on failure"""
+    if make is None:
+        print(f"python,{name},skipped,,,,,")
+        return True
+
+    msg = make()
+    try:
+        with open(os.path.join(corpus, f"{name}.cdr"), "rb") as f:
+            golden = f.read()
+    except OSError:
+        print(f"python,{name},missing,0,,,,")
+        return False
+
+    try:
+        if msg.serialize() != golden:
+            result = "encode_mismatch"
+        else:
+            decoded = type(msg).deserialize(golden)
+            result = "ok" if decoded.serialize() == golden else "roundtrip_mismatch"
+    except Exception:
+        result = "decode_error"
+
+    if result != "ok":
+        print(f"python,{name},{result},{len(golden)},,,,")
+        return False
+
+    encode_ns = ns_per_op(min_seconds, msg.serialize)
+    decode_ns = ns_per_op(min_seconds, lambda: type(msg).deserialize(golden))
+
+    mb = len(golden) / 1e6
+    print(
+        f"python,{name},{result},{len(golden)},{encode_ns:.1f},{decode_ns:.1f},"
+        f"{mb / (encode_ns / 1e9):.3f},{mb / (decode_ns / 1e9):.3f}"
+    )
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CDR golden corpus check (pycdr2)")
+    parser.add_argument("corpus", type=str, help="Corpus directory, e.g.: ../corpus")
+    parser.add_argument("min_seconds", type=float, nargs="?", default=0.2, help="Minimum time per benchmark")
+    args = parser.parse_args()
+
+    print("lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s")
+
+    results = [run_case(name, make, args.corpus, args.min_seconds) for name, make in CASES]
+    sys.exit(0 if all(results) else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,309 @@
+// Copyright (c) 2025 Ziqi Fan
+// SPDX-License-Identifier: Apache-2.0
+
+//! CDR golden corpus conformance and throughput check (Rust codec)
+//!
+//! Same cases and values as cpp/cdr_corpus.cpp. Prints one CSV row per case:
+//!   lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s
+
+use serde::de::DeserializeOwned;
+use serde::{Deserialize, Serialize};
+use std::env;
+use std::hint::black_box;
+use std::path::Path;
+use std::time::{Duration, Instant};
+use zenoh_ros2dds_example::cdr::{self, WString};
+use zenoh_ros2dds_example::msg::{Twist, Vector3};
+
+// ==================== Corpus Types ====================
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct Alignment {
+    a: u8,
+    b: f64,
+    c: u8,
+    d: u16,
+    e: u8,
+    f: u32,
+    g: bool,
+    h: i64,
+    i: i8,
+    j: f32,
+    k: u8,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct Limits {
+    i8_min: i8,
+    u8_max: u8,
+    i16_min: i16,
+    u16_max: u16,
+    i32_min: i32,
+    u32_max: u32,
+    i64_min: i64,
+    u64_max: u64,
+    f32_max: f32,
+    f32_inf: f32,
+    f64_neg_zero: f64,
+    f64_denorm: f64,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct Strings {
+    empty: String,
+    a: u8,
+    odd: String,
+    b: f64,
+    utf8: String,
+    c: u16,
+    names: Vec<String>,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct WStrings {
+    a: u8,
+    text: WString,
+    b: u8,
+    empty: WString,
+    c: u32,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct Point {
+    x: f64,
+    y: f64,
+    z: f64,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct NestedSequences {
+    grid: Vec<Vec<i16>>,
+    tag: u8,
+    points: Vec<Point>,
+    words: Vec<Vec<String>>,
+    empty: Vec<f64>,
+    tail: u8,
+    bytes: Vec<u8>,
+}
+
+#[derive(Serialize, Deserialize, Debug, Clone, Default)]
+struct LargeArrays {
+    head: u8,
+    // float32[1024]; serde derives fixed arrays only up to 32, same bytes on the wire
+    samples: [[f32; 32]; 32],
+    series: Vec<f64>,
+    blob: Vec<u8>,
+}
+
+// ==================== Corpus Values ====================
+
+fn make_alignment() -> Alignment {
+    Alignment {
+        a: 0x11,
+        b: -1.5,
+        c: 0x22,
+        d: 0x3344,
+        e: 0x55,
+        f: 0x66778899,
+        g: true,
+        h: -0x0102030405060708,
+        i: -7,
+        j: 3.25,
+        k: 0x77,
+    }
+}
+
+fn make_limits() -> Limits {
+    Limits {
+        i8_min: i8::MIN,
+        u8_max: u8::MAX,
+        i16_min: i16::MIN,
+        u16_max: u16::MAX,
+        i32_min: i32::MIN,
+        u32_max: u32::MAX,
+        i64_min: i64::MIN,
+        u64_max: u64::MAX,
+        f32_max: f32::MAX,
+        f32_inf: f32::INFINITY,
+        f64_neg_zero: -0.0,
+        f64_denorm: f64::from_bits(1),
+    }
+}
+
+fn make_strings() -> Strings {
+    Strings {
+        empty: String::new(),
+        a: 0x01,
+        odd: "abc".to_string(),
+        b: 2.5,
+        utf8: "héllo wörld ✓".to_string(),
+        c: 0xbeef,
+        names: vec!["".to_string(), "x".to_string(), "yz".to_string()],
+    }
+}
+
+fn make_wstrings() -> WStrings {
+    WStrings {
+        a: 0x01,
+        text: WString("wide ✓ 😀".to_string()),
+        b: 0x02,
+        empty: WString::default(),
+        c: 0xcafef00d,
+    }
+}
+
+fn make_nested_sequences() -> NestedSequences {
+    let point = |x, y, z| Point { x, y, z };
+    NestedSequences {
+        grid: vec![vec![], vec![1], vec![2, -3, 4]],
+        tag: 0x7f,
+        points: vec![
+            point(1.0, 2.0, 3.0),
+            point(-0.5, 0.25, 8.0),
+            point(0.0, 0.0, -1.0),
+        ],
+        words: vec![
+            vec!["a".to_string(), "bc".to_string()],
+            vec![],
+            vec!["def".to_string()],
+        ],
+        empty: vec![],
+        tail: 0x80,
+        bytes: vec![1, 2, 3, 4, 5],
+    }
+}
+
+fn make_large_arrays() -> LargeArrays {
+    let mut m = LargeArrays {
+        head: 0x42,
+        ..Default::default()
+    };
+    for (r, row) in m.samples.iter_mut().enumerate() {
+        for (c, v) in row.iter_mut().enumerate() {
+            *v = (r * 32 + c) as f32 * 0.25;
+        }
+    }
+    m.series = (0..4096).map(|i| i as f64 * 0.5 - 1000.0).collect();
+    m.blob = (0..16384).map(|i: usize| (i * 7) as u8).collect();
+    m
+}
+
+fn make_twist() -> Twist {
+    Twist {
+        linear: Vector3 {
+            x: 1.5,
+            y: -2.25,
+            z: 0.0,
+        },
+        angular: Vector3 {
+            x: 0.0,
+            y: 0.0,
+            z: 0.75,
+        },
+    }
+}
+
+// ==================== Benchmark ====================
+
+/// Run op in doubling batches until min_seconds have elapsed; returns ns per op
+fn ns_per_op<F: FnMut()>(min_seconds: f64, mut op: F) -> f64 {
+    let start = Instant::now();
+    let min_time = Duration::from_secs_f64(min_seconds);
+    let mut count: u64 = 0;
+    let mut batch: u64 = 1;
+    while start.elapsed() < min_time {
+        for _ in 0..batch {
+            op();
+        }
+        count += batch;
+        batch *= 2;
+    }
+    if count == 0 {
+        return 0.0;
+    }
+    start.elapsed().as_nanos() as f64 / count as f64
+}
+
+/// Check one case against corpus/<name>.cdr and print its CSV row; returns true if it passed
+fn run_case<T: Serialize + DeserializeOwned>(
+    name: &str,
+    msg: &T,
+    dir: &Path,
+    min_seconds: f64,
+) -> bool {
+    let golden = std::fs::read(dir.join(format!("{}.cdr", name))).ok();
+    let result = match &golden {
+        None => "missing",
+        Some(golden) => match cdr::serialize(msg) {
+            Ok(data) if data == *golden => match cdr::deserialize::<T>(golden) {
+                Ok(decoded) => match cdr::serialize(&decoded) {
+                    Ok(data) if data == *golden => "ok",
+                    _ => "roundtrip_mismatch",
+                },
+                Err(_) => "decode_error",
+            },
+            _ => "encode_mismatch",
+        },
+    };
+
+    let golden = golden.unwrap_or_default();
+    if result != "ok" {
+        println!("rust,{},{},{},,,,", name, result, golden.len());
+        return false;
+    }
+
+    let encode_ns = ns_per_op(min_seconds, || {
+        black_box(cdr::serialize(black_box(msg)).ok());
+    });
+    let decode_ns = ns_per_op(min_seconds, || {
+        black_box(cdr::deserialize::<T>(black_box(&golden)).ok());
+    });
+
+    let mb = golden.len() as f64 / 1e6;
+    println!(
+        "rust,{},{},{},{:.1},{:.1},{:.3},{:.3}",
+        name,
+        result,
+        golden.len(),
+        encode_ns,
+        decode_ns,
+        mb / (encode_ns / 1e9),
+        mb / (decode_ns / 1e9)
+    );
+    true
+}
+
+fn main() {
+    let args: Vec<String> = env::args().collect();
+
+    let dir = if args.len() > 1 {
+        Path::new(&args[1]).to_path_buf()
+    } else {
+        eprintln!("Error: Corpus directory must be specified");
+        eprintln!("Usage: {} <corpus_dir> [min_seconds]", args[0]);
+        eprintln!("Example: {} ../corpus 0.2", args[0]);
+        std::process::exit(1);
+    };
+    let min_seconds: f64 = args.get(2).and_then(|s| s.parse().ok()).unwrap_or(0.2);
+
+    println!("lang,case,result,bytes,encode_ns,decode_ns,encode_mb_s,decode_mb_s");
+
+    let results = [
+        run_case("alignment", &make_alignment(), &dir, min_seconds),
+        run_case("limits", &make_limits(), &dir, min_seconds),
+        run_case("strings", &make_strings(), &dir, min_seconds),
+        run_case("wstring", &make_wstrings(), &dir, min_seconds),
+        run_case(
+            "nested_sequences",
+            &make_nested_sequences(),
+            &dir,
+            min_seconds,
+        ),
+        run_case("large_arrays", &make_large_arrays(), &dir, min_seconds),
+        run_case("twist", &make_twist(), &dir, min_seconds),
+    ];
+
+    if results.iter().any(|ok| !ok) {
+        std::process::exit(1);
+    }
+}
@@ -14,3 +14,33 @@ pub fn serialize<T: Serialize>(msg: &T) -> Result<Vec<u8>, cdr::Error> {
 pub fn deserialize<'a, T: Deserialize<'a>>(data: &'a [u8]) -> Result<T, cdr::Error> {
     ::cdr::deserialize(data)
 }
+
+/// ROS2 wstring: UTF-16 code units, encoded like cpp/cdr.hpp
+/// (4-byte unit count including the null terminator, then 2-byte units)
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct WString(pub String);
+
+impl Serialize for WString {
+    fn serialize<S: serde::Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        use serde::ser::SerializeSeq;
+        let units: Vec<u16> = self.0.encode_utf16().collect();
+        let mut seq = serializer.serialize_seq(Some(units.len() + 1))?;
+        for unit in &units {
+            seq.serialize_element(unit)?;
+        }
+        seq.serialize_element(&0u16)?;
+        seq.end()
+    }
+}
+
+impl<'de> Deserialize<'de> for WString {
+    fn deserialize<D: serde::Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        let mut units = Vec::<u16>::deserialize(deserializer)?;
+        if units.last() == Some(&0) {
+            units.pop();
+        }
+        String::from_utf16(&units)
+            .map(WString)
+            .map_err(serde::de::Error::custom)
+    }
+}